@@ -4,9 +4,10 @@
 
 namespace {
 
-const TestCaseList& getTests()
+/// Also checked at compile time for constexpr solutions with ENABLE_CONSTEXPR_TESTS.
+constexpr TestCaseList getConstexprTests()
 {
-    static const TestCaseList s_tests{
+    return {
         {
             .m_input{
                 .m_data{ 1, 2, -4 },
@@ -24,6 +25,12 @@ const TestCaseList& getTests()
             },
         },
     };
+}
+
+// inline: solution translation units include this header only for getConstexprTests().
+inline const TestCaseList& getTests()
+{
+    static const TestCaseList s_tests = getConstexprTests();
     return s_tests;
 }
 }
@@ -6,7 +6,7 @@
 
 namespace {
 
-Output solution(const Input& input)
+constexpr Output solution(const Input& input)
 {
     const int64_t result = std::accumulate(input.m_data.cbegin(), input.m_data.cend(), int64_t(0), std::plus<int64_t>());
 
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Problems/ArraySum/ProblemArraySum.h"
+#include "ParallelExecutor.h"
+
+#include <numeric>
+
+namespace {
+
+Output solution(const Input& input, const ParallelExecutor& executor)
+{
+    const std::vector<int>& data = input.m_data;
+    // one slot per range, each is written only once, so false sharing is negligible.
+    std::vector<int64_t> partialSums(executor.getThreadCount());
+    executor.forEachRange(data.size(), [&data, &partialSums](size_t begin, size_t end, size_t index) {
+        partialSums[index] = std::accumulate(data.begin() + begin, data.begin() + end, int64_t(0));
+    });
+    return { .m_value = std::accumulate(partialSums.begin(), partialSums.end(), int64_t(0)) };
+}
+
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Problems/ArraySum/ProblemArraySum.h"
+#include "SolutionPhases.h"
+
+namespace {
+
+// example of CC_PHASE() usage, build with -DENABLE_SOLUTION_PHASES=ON and run with '--print-all-cases 1'.
+Output solution(const Input& input)
+{
+    const int*   data   = input.m_data.data();
+    const size_t size   = input.m_data.size();
+    size_t       i      = 0;
+    int64_t      result = 0;
+    {
+        CC_PHASE("unrolled loop");
+        int64_t acc[4] = {};
+        for (; i + 4 <= size; i += 4) {
+            acc[0] += data[i + 0];
+            acc[1] += data[i + 1];
+            acc[2] += data[i + 2];
+            acc[3] += data[i + 3];
+        }
+        result = acc[0] + acc[1] + acc[2] + acc[3];
+    }
+    CC_PHASE("tail");
+    for (; i < size; ++i)
+        result += data[i];
+
+    return { .m_value = result };
+}
+
+}
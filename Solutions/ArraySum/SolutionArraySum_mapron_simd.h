@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Problems/ArraySum/ProblemArraySum.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define ARRAY_SUM_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+Output solution(const Input& input)
+{
+    const int*   data   = input.m_data.data();
+    const size_t size   = input.m_data.size();
+    size_t       i      = 0;
+    int64_t      result = 0;
+#ifdef ARRAY_SUM_USE_SSE2
+    // widen each int32 to int64 by interleaving it with its sign mask, then sum in two int64 lanes.
+    __m128i accLow  = _mm_setzero_si128();
+    __m128i accHigh = _mm_setzero_si128();
+    for (; i + 4 <= size; i += 4) {
+        const __m128i values = _mm_loadu_si128((const __m128i*) (data + i));
+        const __m128i sign   = _mm_srai_epi32(values, 31);
+        accLow               = _mm_add_epi64(accLow, _mm_unpacklo_epi32(values, sign));
+        accHigh              = _mm_add_epi64(accHigh, _mm_unpackhi_epi32(values, sign));
+    }
+    int64_t lanes[2];
+    _mm_storeu_si128((__m128i*) lanes, _mm_add_epi64(accLow, accHigh));
+    result = lanes[0] + lanes[1];
+#endif
+    for (; i < size; ++i)
+        result += data[i];
+
+    return { .m_value = result };
+}
+
+}
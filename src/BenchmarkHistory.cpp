@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2025 Smirnov Vladimir / mapron1@gmail.com
+ * SPDX-License-Identifier: CC0-1.0
+ * See LICENSE file for details.
+ */
+#include "BenchmarkHistory.h"
+#include "PluginLoader.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#ifdef _WIN32
+#define popen _popen
+#define pclose _pclose
+#define CONTEST_CHECKER_NULL_DEVICE "nul"
+#else
+#define CONTEST_CHECKER_NULL_DEVICE "/dev/null"
+#endif
+
+namespace BenchmarkHistory {
+namespace {
+
+constexpr size_t g_minSegment    = 2;   // variance needs at least two values.
+constexpr double g_minTStatistic = 5.0; // benchmark noise is not normal, so threshold is much bigger than usual 2-3.
+
+/// First line of command output, without line break.
+std::string readCommandLine(const std::string& command)
+{
+    FILE* pipe = popen(command.c_str(), "r");
+    if (!pipe)
+        return {};
+    char        buffer[1024] = {};
+    std::string result       = std::fgets(buffer, sizeof(buffer), pipe) ? buffer : "";
+    pclose(pipe);
+    while (!result.empty() && (result.back() == '\n' || result.back() == '\r'))
+        result.pop_back();
+    return result;
+}
+
+std::string detectRevision()
+{
+#ifdef CONTEST_CHECKER_SOURCE_DIR
+    const std::string git      = "git -C \"" CONTEST_CHECKER_SOURCE_DIR "\" ";
+    std::string       revision = readCommandLine(git + "rev-parse --short=12 HEAD 2>" CONTEST_CHECKER_NULL_DEVICE);
+    if (revision.empty())
+        return "unknown";
+    if (!readCommandLine(git + "status --porcelain --untracked-files=no 2>" CONTEST_CHECKER_NULL_DEVICE).empty())
+        revision += "+dirty";
+    return revision;
+#else
+    return "unknown";
+#endif
+}
+
+struct Stats {
+    double m_mean     = 0;
+    double m_variance = 0; // sample variance.
+};
+
+Stats getStats(const std::vector<double>& prefix, const std::vector<double>& prefixSquares, size_t begin, size_t end)
+{
+    const double n        = double(end - begin);
+    const double sum      = prefix[end] - prefix[begin];
+    const double squares  = prefixSquares[end] - prefixSquares[begin];
+    const double mean     = sum / n;
+    const double variance = std::max((squares - sum * mean) / (n - 1), 0.0);
+    return { mean, variance };
+}
+
+void segment(const std::vector<double>& prefix,
+             const std::vector<double>& prefixSquares,
+             size_t                     begin,
+             size_t                     end,
+             double                     minRelativeShift,
+             std::vector<ChangePoint>&  result)
+{
+    if (end - begin < 2 * g_minSegment)
+        return;
+    double      bestT = 0;
+    ChangePoint best;
+    for (size_t split = begin + g_minSegment; split + g_minSegment <= end; ++split) {
+        const Stats  before = getStats(prefix, prefixSquares, begin, split);
+        const Stats  after  = getStats(prefix, prefixSquares, split, end);
+        const double error  = std::sqrt(before.m_variance / double(split - begin) + after.m_variance / double(end - split));
+        const double diff   = std::abs(after.m_mean - before.m_mean);
+        // identical measurements give zero error; any shift between them is then certain.
+        const double t = error > 0 ? diff / error : (diff > 0 ? INFINITY : 0);
+        if (t > bestT) {
+            bestT = t;
+            best  = { split, before.m_mean, after.m_mean };
+        }
+    }
+    if (bestT < g_minTStatistic || std::abs(best.m_meanAfter - best.m_meanBefore) < minRelativeShift * best.m_meanBefore)
+        return;
+    segment(prefix, prefixSquares, begin, best.m_index, minRelativeShift, result);
+    result.push_back(best);
+    segment(prefix, prefixSquares, best.m_index, end, minRelativeShift, result);
+}
+
+}
+
+std::string getDefaultPath()
+{
+    return PluginLoader::getArtifactPath(0) + ".history";
+}
+
+const std::string& getRevision()
+{
+    static const std::string s_revision = detectRevision();
+    return s_revision;
+}
+
+void append(const std::string& path, const Record& record)
+{
+    std::ofstream os(path, std::ios::app);
+    os << record.m_timestamp << '\t' << record.m_problem << '\t' << record.m_student << '\t' << record.m_impl << '\t'
+       << record.m_sources << '\t' << record.m_revision << '\t' << record.m_host << '\t' << std::setprecision(12) << record.m_nsPerIteration << '\n';
+}
+
+std::vector<Record> load(const std::string& path)
+{
+    std::vector<Record> result;
+    std::ifstream       is(path);
+    std::string         line;
+    while (std::getline(is, line)) {
+        std::istringstream fields(line);
+        Record             record;
+        std::string        timestamp, nsPerIteration;
+        if (!std::getline(fields, timestamp, '\t') || !std::getline(fields, record.m_problem, '\t')
+            || !std::getline(fields, record.m_student, '\t') || !std::getline(fields, record.m_impl, '\t')
+            || !std::getline(fields, record.m_sources, '\t') || !std::getline(fields, record.m_revision, '\t')
+            || !std::getline(fields, record.m_host, '\t') || !std::getline(fields, nsPerIteration))
+            continue; // line could be cut by interrupted write.
+        record.m_timestamp      = std::atoll(timestamp.c_str());
+        record.m_nsPerIteration = std::atof(nsPerIteration.c_str());
+        if (record.m_nsPerIteration > 0)
+            result.push_back(std::move(record));
+    }
+    return result;
+}
+
+std::vector<ChangePoint> detectChangePoints(const std::vector<double>& values, double minRelativeShift)
+{
+    std::vector<double> prefix(values.size() + 1), prefixSquares(values.size() + 1);
+    for (size_t i = 0; i < values.size(); ++i) {
+        prefix[i + 1]        = prefix[i] + values[i];
+        prefixSquares[i + 1] = prefixSquares[i] + values[i] * values[i];
+    }
+    std::vector<ChangePoint> result;
+    segment(prefix, prefixSquares, 0, values.size(), minRelativeShift, result);
+    return result;
+}
+
+}
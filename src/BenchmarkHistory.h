@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2025 Smirnov Vladimir / mapron1@gmail.com
+ * SPDX-License-Identifier: CC0-1.0
+ * See LICENSE file for details.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// Append-only log of Benchmark task results, for finding gradual regressions across commits.
+/// File is a text file, one tab-separated record per line, in the order results were measured.
+namespace BenchmarkHistory {
+
+struct Record {
+    int64_t     m_timestamp = 0; // unix time, seconds.
+    std::string m_problem;
+    std::string m_student;
+    std::string m_impl;
+    std::string m_sources;       // source filter of the run, "*" for all test sources; different sources are different series.
+    std::string m_revision;      // git revision of source tree, with "+dirty" suffix if it has uncommitted changes.
+    std::string m_host;          // Calibration::getHostFingerprint().
+    double      m_nsPerIteration = 0; // one pass over all test cases.
+};
+
+/// Default history file is placed near the executable.
+std::string getDefaultPath();
+
+/// Revision of the source tree checker was built from; "unknown" if git is not available. Evaluated once per process.
+const std::string& getRevision();
+
+void                append(const std::string& path, const Record& record);
+std::vector<Record> load(const std::string& path);
+
+/// Point where mean of the series shifts: values [m_index, ...) differ from values before it.
+struct ChangePoint {
+    size_t m_index      = 0;
+    double m_meanBefore = 0;
+    double m_meanAfter  = 0;
+};
+
+/// Binary segmentation: the split with the biggest Welch t-statistic is taken if it is significant and mean shifts
+/// by at least minRelativeShift, then both halves are searched recursively. Result is ordered by index.
+std::vector<ChangePoint> detectChangePoints(const std::vector<double>& values, double minRelativeShift = 0.03);
+
+}
@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2025 Smirnov Vladimir / mapron1@gmail.com
+ * SPDX-License-Identifier: CC0-1.0
+ * See LICENSE file for details.
+ */
+#include "Calibration.h"
+#include "CustomAlloc.h"
+#include "PluginLoader.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace Calibration {
+namespace {
+
+constexpr size_t g_bandwidthBufferSize  = 64 << 20; // should exceed last level cache.
+constexpr int    g_bandwidthRepetitions = 5;
+constexpr size_t g_latencyBufferSize    = 64 << 20;
+constexpr size_t g_latencySteps         = 1 << 21;
+constexpr size_t g_integerIterations    = 1 << 24;
+constexpr int    g_integerRepetitions   = 3;
+
+/// Nominal scores of reference machine (typical desktop of 2020) time limits in Problem.txt are written for.
+constexpr Scores g_reference{ .m_integerOpsPerNs = 6.0, .m_memoryLatencyNs = 90.0, .m_memoryBandwidth = 20e9 };
+
+std::string s_cachePath;
+bool        s_cached = false;
+
+double measureMemoryBandwidth()
+{
+    // vector value-initialization also touches every page, so page faults are not measured.
+    std::vector<char> source(g_bandwidthBufferSize, 1);
+    std::vector<char> destination(g_bandwidthBufferSize, 0);
+
+    // memcpy is optimized by C library regardless of checker build type; best run is taken, as in STREAM.
+    int64_t bestNs = std::numeric_limits<int64_t>::max();
+    for (int i = 0; i < g_bandwidthRepetitions; ++i) {
+        const int64_t startNs = PerformanceCounterDetails::getCurrentNanoseconds();
+        std::memcpy(destination.data(), source.data(), g_bandwidthBufferSize);
+        bestNs = std::min(bestNs, PerformanceCounterDetails::getCurrentNanoseconds() - startNs);
+        source[i] = destination[g_bandwidthBufferSize - 1 - i]; // prevent optimizing copies away.
+    }
+    return 2.0 * g_bandwidthBufferSize / (std::max<int64_t>(bestNs, 1) / 1e9);
+}
+
+double measureMemoryLatency()
+{
+    // one pointer per cache line, linked into single random cycle (Sattolo), so prefetcher can not guess next load.
+    constexpr size_t    lineSize = 64 / sizeof(size_t);
+    const size_t        lines    = g_latencyBufferSize / 64;
+    std::vector<size_t> order(lines);
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::mt19937_64 rng(lines);
+    for (size_t i = lines - 1; i > 0; --i)
+        std::swap(order[i], order[rng() % i]);
+    std::vector<size_t> next(g_latencyBufferSize / sizeof(size_t));
+    for (size_t i = 0; i < lines; ++i)
+        next[i * lineSize] = order[i] * lineSize;
+
+    size_t        position = 0;
+    const int64_t startNs  = PerformanceCounterDetails::getCurrentNanoseconds();
+    for (size_t i = 0; i < g_latencySteps; ++i)
+        position = next[position];
+    const int64_t elapsedNs = PerformanceCounterDetails::getCurrentNanoseconds() - startNs;
+    next[0] += position & 1; // prevent optimizing chase away.
+    return double(elapsedNs) / g_latencySteps;
+}
+
+double measureIntegerOps()
+{
+    // four independent chains, so result depends on both latency and throughput of ALU, as most solutions do.
+    int64_t  bestNs = std::numeric_limits<int64_t>::max();
+    uint64_t sink   = 0;
+    for (int r = 0; r < g_integerRepetitions; ++r) {
+        uint64_t      a = 1 + r, b = 2 + r, c = 3 + r, d = 4 + r;
+        const int64_t startNs = PerformanceCounterDetails::getCurrentNanoseconds();
+        for (size_t i = 0; i < g_integerIterations; ++i) {
+            a = (a ^ (a >> 7)) * 0x9E3779B97F4A7C15ULL + i;
+            b = (b ^ (b >> 11)) * 0xC2B2AE3D27D4EB4FULL + i;
+            c = (c ^ (c >> 13)) * 0x165667B19E3779F9ULL + i;
+            d = (d ^ (d >> 17)) * 0x85EBCA77C2B2AE63ULL + i;
+        }
+        bestNs = std::min(bestNs, PerformanceCounterDetails::getCurrentNanoseconds() - startNs);
+        sink += a ^ b ^ c ^ d;
+    }
+    // result must be used, otherwise chains are optimized away.
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r"(sink));
+#else
+    static volatile uint64_t s_sink;
+    s_sink = sink;
+#endif
+    // xor, shift, multiply and add per chain.
+    return 4.0 * 4 * g_integerIterations / std::max<int64_t>(bestNs, 1);
+}
+
+std::string readCpuModel()
+{
+#ifdef _WIN32
+    const char* identifier = std::getenv("PROCESSOR_IDENTIFIER");
+    return identifier ? identifier : "";
+#else
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string   line;
+    while (std::getline(cpuinfo, line)) {
+        if (line.starts_with("model name")) {
+            const size_t colon = line.find(':');
+            return colon == std::string::npos ? line : line.substr(std::min(colon + 2, line.size()));
+        }
+    }
+    return {};
+#endif
+}
+
+std::string readHostName()
+{
+#ifdef _WIN32
+    const char* name = std::getenv("COMPUTERNAME");
+    return name ? name : "";
+#else
+    char buffer[256] = {};
+    ::gethostname(buffer, sizeof(buffer) - 1);
+    return buffer;
+#endif
+}
+
+bool loadCached(const std::string& fingerprint, Scores& scores)
+{
+    std::ifstream file(s_cachePath);
+    std::string   line;
+    while (std::getline(file, line)) {
+        std::istringstream is(line);
+        std::string        key;
+        if (std::getline(is, key, '\t') && key == fingerprint)
+            return bool(is >> scores.m_integerOpsPerNs >> scores.m_memoryLatencyNs >> scores.m_memoryBandwidth);
+    }
+    return false;
+}
+
+void storeCached(const std::string& fingerprint, const Scores& scores)
+{
+    std::vector<std::string> lines;
+    {
+        std::ifstream file(s_cachePath);
+        std::string   line;
+        while (std::getline(file, line)) {
+            if (!line.starts_with(fingerprint + '\t'))
+                lines.push_back(line);
+        }
+    }
+    std::ostringstream entry;
+    entry << fingerprint << '\t' << scores.m_integerOpsPerNs << '\t' << scores.m_memoryLatencyNs << '\t' << scores.m_memoryBandwidth;
+    lines.push_back(entry.str());
+
+    std::ofstream file(s_cachePath, std::ios::trunc);
+    for (const std::string& line : lines)
+        file << line << '\n';
+}
+
+Scores measureScores()
+{
+    const std::string fingerprint = getHostFingerprint();
+    Scores            scores;
+    if (!s_cachePath.empty() && loadCached(fingerprint, scores)) {
+        s_cached = true;
+        return scores;
+    }
+    scores.m_integerOpsPerNs = measureIntegerOps();
+    scores.m_memoryLatencyNs = measureMemoryLatency();
+    scores.m_memoryBandwidth = measureMemoryBandwidth();
+    if (!s_cachePath.empty())
+        storeCached(fingerprint, scores);
+    return scores;
+}
+
+}
+
+std::string getHostFingerprint()
+{
+    std::string result = readHostName() + "|" + readCpuModel() + "|" + std::to_string(std::thread::hardware_concurrency());
+    std::replace_if(result.begin(), result.end(), [](char c) { return c == '\t' || c == '\n' || c == '\r'; }, ' ');
+    return result;
+}
+
+void setCachePath(const std::string& path)
+{
+    s_cachePath = path;
+}
+
+std::string getDefaultCachePath()
+{
+    return PluginLoader::getArtifactPath(0) + ".calibration";
+}
+
+const Scores& getScores()
+{
+    static const Scores s_scores = measureScores();
+    return s_scores;
+}
+
+bool isCached()
+{
+    getScores();
+    return s_cached;
+}
+
+double getSpeedFactor()
+{
+    const Scores& scores    = getScores();
+    const double  integer   = scores.m_integerOpsPerNs / g_reference.m_integerOpsPerNs;
+    const double  latency   = g_reference.m_memoryLatencyNs / std::max(scores.m_memoryLatencyNs, 1e-3);
+    const double  bandwidth = scores.m_memoryBandwidth / g_reference.m_memoryBandwidth;
+    return std::cbrt(integer * latency * bandwidth);
+}
+
+double getMemoryBandwidth()
+{
+    return getScores().m_memoryBandwidth;
+}
+
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright (C) 2025 Smirnov Vladimir / mapron1@gmail.com
+ * SPDX-License-Identifier: CC0-1.0
+ * See LICENSE file for details.
+ */
+#pragma once
+
+#include <string>
+
+/// Measurements of the machine itself, used as baseline for solution metrics.
+namespace Calibration {
+
+/// Results of the calibration micro-suite; bigger is faster except latency.
+struct Scores {
+    double m_integerOpsPerNs = 0; // multiply/xor/shift chains, executed from registers.
+    double m_memoryLatencyNs = 0; // random dependent loads from buffer larger than caches.
+    double m_memoryBandwidth = 0; // bytes per second, read + write.
+};
+
+/// Host name, CPU model and hardware thread count; results measured on one host are not reused on another.
+std::string getHostFingerprint();
+
+/// File with scores measured before, one line per host fingerprint. Empty path disables caching.
+void        setCachePath(const std::string& path);
+std::string getDefaultCachePath();
+
+/// Runs micro-suite on first call (unless cached for this host), later returns the same scores.
+const Scores& getScores();
+
+/// Whether getScores() were loaded from cache file instead of measured by this process.
+bool isCached();
+
+/// Speed of this machine relative to reference one, geometric mean of three score ratios; 2.0 is twice faster.
+/// Time limits from Problem.txt are declared for reference machine and divided by this factor.
+double getSpeedFactor();
+
+/// Main memory bandwidth in bytes per second (read + write), measured with STREAM-like copy of buffers larger than caches.
+double getMemoryBandwidth();
+
+}
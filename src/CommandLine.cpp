@@ -5,9 +5,11 @@
  */
 #include "CommandLine.h"
 
+#include <cstdlib>
 #include <iostream>
 #include <set>
 #include <fstream>
+#include <regex>
 #include <sstream>
 
 namespace {
@@ -16,6 +18,94 @@ bool isTrueValue(const std::string& value)
     return !(value.empty() || value == "0" || value == "false");
 }
 
+std::vector<std::string> splitList(const std::string& value)
+{
+    std::vector<std::string> result;
+    std::istringstream       is(value);
+    std::string              item;
+    while (std::getline(is, item, ','))
+        if (!item.empty())
+            result.push_back(item);
+    return result;
+}
+
+/// Simple wildcard matching, '*' is any sequence, '?' is any character.
+bool globMatches(std::string_view pattern, std::string_view name)
+{
+    size_t p = 0, n = 0, starP = std::string_view::npos, starN = 0;
+    while (n < name.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])) {
+            ++p;
+            ++n;
+        } else if (p < pattern.size() && pattern[p] == '*') {
+            starP = p++;
+            starN = n;
+        } else if (starP != std::string_view::npos) {
+            p = starP + 1;
+            n = ++starN;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*')
+        ++p;
+    return p == pattern.size();
+}
+
+}
+
+struct CLIParams::NameFilter::Compiled {
+    std::set<std::string, std::less<>> m_exact;
+    std::vector<std::string>           m_globs;
+    std::vector<std::regex>            m_regexes;
+};
+
+bool CLIParams::NameFilter::matches(std::string_view name) const
+{
+    if (!m_compiled)
+        return true;
+    if (m_compiled->m_exact.contains(name))
+        return true;
+    for (const auto& glob : m_compiled->m_globs) {
+        if (globMatches(glob, name))
+            return true;
+    }
+    for (const auto& regex : m_compiled->m_regexes) {
+        if (std::regex_match(name.begin(), name.end(), regex))
+            return true;
+    }
+    return false;
+}
+
+bool CLIParams::NameFilter::set(std::ostream& logStream, const std::string& value)
+{
+    auto compiled = std::make_shared<Compiled>();
+    for (const std::string& pattern : splitList(value)) {
+        if (pattern.starts_with("re:")) {
+            try {
+                compiled->m_regexes.emplace_back(pattern.substr(3));
+            }
+            catch (std::regex_error& ex) {
+                logStream << "Invalid regex '" << pattern << "': " << ex.what() << "\n";
+                return false;
+            }
+        } else if (pattern.find_first_of("*?") != std::string::npos) {
+            compiled->m_globs.push_back(pattern);
+        } else {
+            compiled->m_exact.insert(pattern);
+        }
+    }
+    m_value    = value;
+    m_compiled = value.empty() ? nullptr : std::move(compiled);
+    return true;
+}
+
+void CLIParams::NameFilter::setExact(const std::string& name)
+{
+    auto compiled = std::make_shared<Compiled>();
+    compiled->m_exact.insert(name);
+    m_value    = name;
+    m_compiled = std::move(compiled);
 }
 
 struct CLIParams::Impl {
@@ -23,6 +113,7 @@ struct CLIParams::Impl {
     std::ifstream m_testOutput;
     std::ofstream m_print;
     std::ofstream m_log;
+    std::ofstream m_profile;
 
     std::ostringstream m_nullStream;
 };
@@ -78,6 +169,34 @@ bool CLIParams::parseArgs(std::ostream& logStream, const std::map<std::string, s
         "log-to",
         "print-all-cases",
         "enable-alloc-trace",
+        "socket",
+        "incremental",
+        "plugins",
+        "cache-file",
+        "no-cache",
+        "shard",
+        "source",
+        "workers",
+        "unit-timeout",
+        "listen",
+        "connect",
+        "profile",
+        "profile-folded",
+        "trace-file",
+        "threads",
+        "copies",
+        "test-arena",
+        "test-arena-huge-pages",
+        "test-arena-prefault",
+        "test-arena-willneed",
+        "test-arena-lock",
+        "stress-dir",
+        "stress-seed",
+        "hash-outputs-above",
+        "calibration-file",
+        "time-limits",
+        "history-file",
+        "unit",
     };
     bool result = true;
     for (const auto& [key, value] : argsMap) {
@@ -87,8 +206,11 @@ bool CLIParams::parseArgs(std::ostream& logStream, const std::map<std::string, s
             continue;
         }
 
-        if (!parseArg(logStream, key, value))
+        if (!parseArg(logStream, key, value)) {
             result = false;
+            continue;
+        }
+        m_parsedArgs[key] = value;
     }
     return result;
 }
@@ -96,11 +218,37 @@ bool CLIParams::parseArgs(std::ostream& logStream, const std::map<std::string, s
 bool CLIParams::parseArg(std::ostream& logStream, const std::string& option, const std::string& value)
 {
     if (option == "problem")
-        m_problemNameFilter = value;
+        return m_problemNameFilter.set(logStream, value);
     else if (option == "impl")
-        m_implNameFilter = value;
+        return m_implNameFilter.set(logStream, value);
     else if (option == "student")
-        m_studentFilter = value;
+        return m_studentFilter.set(logStream, value);
+    else if (option == "source")
+        return m_sourceFilter.set(logStream, value);
+    else if (option == "unit") {
+        // work unit of distributed run: exact problem, student, impl and source names, separated by tabs.
+        std::vector<std::string> names;
+        std::istringstream       is(value);
+        for (std::string name; std::getline(is, name, '\t');)
+            names.push_back(name);
+        if (names.size() != 4) {
+            logStream << "Unit must be 'problem<TAB>student<TAB>impl<TAB>source', got '" << value << "'\n";
+            return false;
+        }
+        m_problemNameFilter.setExact(names[0]);
+        m_studentFilter.setExact(names[1]);
+        m_implNameFilter.setExact(names[2]);
+        m_sourceFilter.setExact(names[3]);
+    }
+    else if (option == "shard") {
+        char               separator = 0;
+        std::istringstream is(value);
+        if (!(is >> m_shardIndex >> separator >> m_shardCount) || separator != '/' || m_shardCount == 0
+            || m_shardIndex == 0 || m_shardIndex > m_shardCount) {
+            logStream << "Shard must be in format 'index/count', index from 1 to count, got '" << value << "'\n";
+            return false;
+        }
+    }
 
     else if (option == "test-input")
         m_testInputFile = value;
@@ -110,11 +258,71 @@ bool CLIParams::parseArg(std::ostream& logStream, const std::string& option, con
         m_printFile = value;
     else if (option == "log-to")
         m_logFile = value;
+    else if (option == "socket")
+        m_socketPath = value;
+    else if (option == "plugins")
+        m_pluginPaths = splitList(value);
+    else if (option == "cache-file")
+        m_cacheFile = value;
+    else if (option == "listen")
+        m_listenAddress = value;
+    else if (option == "connect")
+        m_connectAddress = value;
+    else if (option == "trace-file")
+        m_traceFile = value;
+    else if (option == "stress-dir")
+        m_stressDir = value;
+    else if (option == "calibration-file")
+        m_calibrationFile = value;
+    else if (option == "history-file")
+        m_historyFile = value;
+    else if (option == "stress-seed")
+        m_stressSeed = std::strtoull(value.c_str(), nullptr, 10);
+    else if (option == "profile-folded") {
+        m_profileFoldedFile = value;
+        m_profile           = true;
+    }
+    else if (option == "workers")
+        m_workerCount = std::atoi(value.c_str());
+    else if (option == "unit-timeout")
+        m_unitTimeoutS = std::atoi(value.c_str());
+    else if (option == "threads")
+        m_threadCount = std::atoi(value.c_str());
+    else if (option == "copies")
+        m_copyCount = std::atoi(value.c_str());
+    else if (option == "hash-outputs-above")
+        m_hashOutputsAboveMB = std::atoll(value.c_str());
 
     else if (option == "print-all-cases")
         m_printAllCases = isTrueValue(value);
     else if (option == "enable-alloc-trace")
         m_enableAllocTrace = isTrueValue(value);
+    else if (option == "incremental")
+        m_incremental = isTrueValue(value);
+    else if (option == "no-cache")
+        m_noCache = isTrueValue(value);
+    else if (option == "profile")
+        m_profile = isTrueValue(value);
+    else if (option == "test-arena")
+        m_testArena = isTrueValue(value);
+    else if (option == "time-limits")
+        m_timeLimits = isTrueValue(value);
+    else if (option == "test-arena-huge-pages") {
+        m_testArenaHugePages = isTrueValue(value);
+        m_testArena          = m_testArena || m_testArenaHugePages;
+    }
+    else if (option == "test-arena-prefault") {
+        m_testArenaPrefault = isTrueValue(value);
+        m_testArena         = m_testArena || m_testArenaPrefault;
+    }
+    else if (option == "test-arena-willneed") {
+        m_testArenaWillNeed = isTrueValue(value);
+        m_testArena         = m_testArena || m_testArenaWillNeed;
+    }
+    else if (option == "test-arena-lock") {
+        m_testArenaLock = isTrueValue(value);
+        m_testArena     = m_testArena || m_testArenaLock;
+    }
 
     else if (option == "task") {
         if (value == "CheckOutput")
@@ -123,23 +331,33 @@ bool CLIParams::parseArg(std::ostream& logStream, const std::string& option, con
             m_task = Task::PrintOutput;
         else if (value == "Benchmark")
             m_task = Task::Benchmark;
+        else if (value == "Serve")
+            m_task = Task::Serve;
+        else if (value == "Scaling")
+            m_task = Task::Scaling;
+        else if (value == "Contention")
+            m_task = Task::Contention;
+        else if (value == "Stress")
+            m_task = Task::Stress;
+        else if (value == "History")
+            m_task = Task::History;
     }
     return true;
 }
 
 bool CLIParams::isFilteredProblem(std::string_view problem) const
 {
-    return (!m_problemNameFilter.empty() && problem != m_problemNameFilter);
+    return !m_problemNameFilter.matches(problem);
 }
 
 bool CLIParams::isFilteredImpl(std::string_view implName) const
 {
-    return (!m_implNameFilter.empty() && implName != m_implNameFilter);
+    return !m_implNameFilter.matches(implName);
 }
 
 bool CLIParams::isFilteredStudent(std::string_view name) const
 {
-    return (!m_studentFilter.empty() && name != m_studentFilter);
+    return !m_studentFilter.matches(name);
 }
 
 void CLIParams::createStreams()
@@ -190,4 +408,5 @@ void CLIParams::createStreams()
 
     makeOutputFile(m_printFile, m_printStream, m_impl->m_print);
     makeOutputFile(m_logFile, m_loggingStream, m_impl->m_log);
+    makeOutputFile(m_profileFoldedFile, m_profileStream, m_impl->m_profile);
 }
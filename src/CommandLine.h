@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -19,6 +20,11 @@ public:
         CheckOutput,
         PrintOutput,
         Benchmark,
+        Serve,
+        Scaling,
+        Contention,
+        Stress,
+        History,
     };
     struct Ordering {
         std::map<std::string_view, int> m_order;
@@ -29,6 +35,23 @@ public:
             return it == m_order.end() ? INT_MAX : it->second;
         }
     };
+    /// Comma-separated list of names; each can be exact name, glob (with '*' and '?') or regex with 're:' prefix.
+    /// Empty filter matches everything.
+    struct NameFilter {
+        struct Compiled;
+
+        std::string                     m_value;
+        std::shared_ptr<const Compiled> m_compiled;
+
+        bool empty() const { return m_value.empty(); }
+        bool matches(std::string_view name) const;
+
+        /// Returns false if any regex is invalid.
+        bool set(std::ostream& logStream, const std::string& value);
+
+        /// Match only this name, even if it contains pattern characters.
+        void setExact(const std::string& name);
+    };
     struct Impl;
 
     // magic constants for file parameters.
@@ -42,15 +65,34 @@ public:
     std::istream* m_testOutputStream = nullptr;
     std::ostream* m_printStream      = nullptr;
     std::ostream* m_loggingStream    = nullptr;
+    std::ostream* m_profileStream    = nullptr; // folded stacks output.
 
     std::string m_testInputFile;
     std::string m_testOutputFile;
     std::string m_printFile;
     std::string m_logFile;
+    std::string m_socketPath;
+    std::string m_cacheFile;
+    std::string m_listenAddress = "127.0.0.1:0";
+    std::string m_connectAddress;
+    std::string m_profileFoldedFile;
+    std::string m_traceFile;
+    std::string m_stressDir = "stress"; // found worst inputs are saved to <dir>/<problem>/.
+    std::string m_calibrationFile;      // machine scores cache; empty is default path, "null" disables caching.
+    std::string m_historyFile;          // benchmark results log; empty is default path, "null" disables it.
+
+    std::vector<std::string> m_pluginPaths;
+
+    std::map<std::string, std::string> m_parsedArgs; // accepted options without leading "--", to pass them to other processes.
+
+    NameFilter m_problemNameFilter;
+    NameFilter m_implNameFilter;
+    NameFilter m_studentFilter;
+    NameFilter m_sourceFilter;
 
-    std::string m_problemNameFilter;
-    std::string m_implNameFilter;
-    std::string m_studentFilter;
+    // run only solutions of shard m_shardIndex (1-based) from m_shardCount, distributed by solution id hash.
+    uint64_t m_shardIndex = 1;
+    uint64_t m_shardCount = 1;
 
     Ordering m_problemNameOrdering;
     Ordering m_implNameOrdering;
@@ -59,8 +101,27 @@ public:
     Task m_task = Task::CheckOutput;
 
     int64_t m_benchmarkTimeLimitMS = 10000; // 10 sec.
+    int64_t m_hashOutputsAboveMB   = 64;    // expected output files of this size are compared by digest.
     bool    m_printAllCases        = false;
     bool    m_enableAllocTrace     = false;
+    bool    m_incremental          = true;
+    bool    m_noCache              = false;
+    bool    m_profile              = false; // sample call stacks during benchmark.
+    bool    m_testArena            = false; // load test data into contiguous arena.
+    bool    m_testArenaHugePages   = false;
+    bool    m_testArenaPrefault    = false;
+    bool    m_testArenaWillNeed    = false;
+    bool    m_testArenaLock        = false;
+    bool    m_timeLimits           = true; // check "Time limit" of Problem.txt, scaled to this machine.
+    int     m_workerCount          = -1; // coordinator mode is enabled when it is not negative.
+    int     m_unitTimeoutS         = 600; // worker that runs one unit longer is dropped, unit is retried.
+    int     m_threadCount          = 0;  // for parallel solutions; 0 is hardware concurrency.
+    int     m_copyCount            = 0;  // concurrent copies in Contention task; 0 is hardware concurrency.
+
+    uint64_t m_stressSeed = 1; // random seed of Stress task mutations.
+
+    /// Ids of solutions that already passed CheckOutput and can be skipped; set only in server mode.
+    std::set<std::string>* m_passedSolutions = nullptr;
 
 public:
     CLIParams();
@@ -82,6 +143,8 @@ public:
     bool isFilteredProblem(std::string_view problem) const;
     bool isFilteredImpl(std::string_view implName) const;
     bool isFilteredStudent(std::string_view name) const;
+    bool isFilteredSource(std::string_view source) const { return !m_sourceFilter.matches(source); }
+    bool isFilteredShard(uint64_t solutionIdHash) const { return solutionIdHash % m_shardCount != m_shardIndex - 1; }
 
     bool useStdin() const { return m_testInputFile == g_stdin; }
 
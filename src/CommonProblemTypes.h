@@ -7,7 +7,12 @@
 
 #include "CommonProblemTypesDetails.h"
 
+#include <bit>
+#include <cstring>
+#include <initializer_list>
 #include <limits>
+#include <stdexcept>
+#include <string_view>
 
 /// Common problem inputs and outputs that can be reused between problems.
 namespace CommonTypes {
@@ -18,9 +23,13 @@ struct NumericScalarIO {
 
     auto operator<=>(const NumericScalarIO&) const = default;
 
+    size_t elementCount() const { return 1; }
+    size_t byteCount() const { return sizeof(T); }
+
     void log(std::ostream& os) const { Details::logValue(os, m_value); }
     void writeTo(std::ostream& os) const { Details::writeToImpl(os, m_value); }
     void readFrom(std::istream& is) & { Details::readFromImpl(is, m_value); }
+    void mutate(std::mt19937_64& rng) & { Details::mutateValue(m_value, rng); }
 };
 
 template<Details::Numeric T>
@@ -30,6 +39,9 @@ struct NumericRangeIO {
 
     auto operator<=>(const NumericRangeIO&) const = default;
 
+    size_t elementCount() const { return 1; }
+    size_t byteCount() const { return 2 * sizeof(T); }
+
     std::string toString() const { return Details::logValueAsString(*this); }
 
     void log(std::ostream& os) const
@@ -50,6 +62,7 @@ struct NumericRangeIO {
         Details::readFromImpl(is, m_start);
         Details::readFromImpl(is, m_end);
     }
+    void mutate(std::mt19937_64& rng) & { Details::mutateValue(rng() % 2 ? m_start : m_end, rng); }
 };
 
 template<Details::Numeric T>
@@ -59,6 +72,9 @@ struct NumericPointIO {
 
     auto operator<=>(const NumericPointIO&) const = default;
 
+    size_t elementCount() const { return 1; }
+    size_t byteCount() const { return 2 * sizeof(T); }
+
     std::string toString() const { return Details::logValueAsString(*this); }
 
     void log(std::ostream& os) const
@@ -79,6 +95,7 @@ struct NumericPointIO {
         Details::readFromImpl(is, m_x);
         Details::readFromImpl(is, m_y);
     }
+    void mutate(std::mt19937_64& rng) & { Details::mutateValue(rng() % 2 ? m_x : m_y, rng); }
 };
 
 struct StringScalarIO {
@@ -86,6 +103,9 @@ struct StringScalarIO {
 
     auto operator<=>(const StringScalarIO&) const = default;
 
+    size_t elementCount() const { return m_text.size(); }
+    size_t byteCount() const { return m_text.size(); }
+
     void log(std::ostream& os) const
     {
         Details::logValue(os, m_text);
@@ -98,13 +118,23 @@ struct StringScalarIO {
     {
         Details::readFromImpl(is, m_text);
     }
+    void mutate(std::mt19937_64& rng) & { Details::mutateValue(m_text, rng); }
 };
 
 template<typename T>
 struct ArrayIO {
     std::vector<T> m_data;
 
-    bool operator==(const ArrayIO&) const = default;
+    constexpr bool operator==(const ArrayIO& other) const { return Details::equalArrays(m_data, other.m_data); }
+
+    size_t elementCount() const { return m_data.size(); }
+    size_t byteCount() const { return Details::arrayByteCount(m_data); }
+
+    uint32_t checksum() const
+        requires Details::Kernels::Vectorizable<T>
+    {
+        return Details::Kernels::checksum(std::span<const T>(m_data.data(), m_data.size()));
+    }
 
     void log(std::ostream& os) const { Details::logArray(os, m_data); }
 
@@ -126,6 +156,8 @@ struct ArrayIO {
             Details::readFromImpl(is, m_data[i]);
         }
     }
+
+    void mutate(std::mt19937_64& rng) & { Details::mutateArray(m_data, rng); }
 };
 
 template<typename ArrayElemType, typename ValueType, Details::CompileTimeLiteral valueName>
@@ -134,7 +166,13 @@ struct ArrayWithValueIO {
 
     ValueType m_value;
 
-    bool operator==(const ArrayWithValueIO&) const = default;
+    constexpr bool operator==(const ArrayWithValueIO& other) const
+    {
+        return m_value == other.m_value && Details::equalArrays(m_data, other.m_data);
+    }
+
+    size_t elementCount() const { return m_data.size(); }
+    size_t byteCount() const { return Details::arrayByteCount(m_data) + Details::byteCountOf(m_value); }
 
     void log(std::ostream& os) const
     {
@@ -164,48 +202,850 @@ struct ArrayWithValueIO {
             Details::readFromImpl(is, m_data[i]);
         }
     }
+
+    void mutate(std::mt19937_64& rng) &
+    {
+        if (m_data.empty() || rng() % 8 == 0)
+            Details::mutateValue(m_value, rng);
+        else
+            Details::mutateArray(m_data, rng);
+    }
+};
+
+/// Points in struct-of-arrays layout: separate contiguous x[] and y[] arrays, so solutions can process them with SIMD.
+/// Text format is the same as ArrayIO<NumericPointIO<T>>: count, then "x y" per line.
+template<Details::Kernels::Vectorizable T>
+struct PointsSoAIO {
+    std::vector<T> m_x;
+    std::vector<T> m_y;
+
+    static PointsSoAIO fromPoints(std::span<const NumericPointIO<T>> points)
+    {
+        PointsSoAIO result;
+        result.m_x.resize(points.size());
+        result.m_y.resize(points.size());
+        for (size_t i = 0; i < points.size(); ++i) {
+            result.m_x[i] = points[i].m_x;
+            result.m_y[i] = points[i].m_y;
+        }
+        return result;
+    }
+    static PointsSoAIO fromPoints(std::initializer_list<NumericPointIO<T>> points)
+    {
+        return fromPoints(std::span<const NumericPointIO<T>>(points.begin(), points.size()));
+    }
+
+    size_t size() const { return m_x.size(); }
+
+    NumericPointIO<T> get(size_t index) const { return { m_x[index], m_y[index] }; }
+
+    void push_back(const NumericPointIO<T>& point)
+    {
+        m_x.push_back(point.m_x);
+        m_y.push_back(point.m_y);
+    }
+
+    bool operator==(const PointsSoAIO& other) const
+    {
+        return Details::equalArrays(m_x, other.m_x) && Details::equalArrays(m_y, other.m_y);
+    }
+
+    size_t elementCount() const { return size(); }
+    size_t byteCount() const { return Details::arrayByteCount(m_x) + Details::arrayByteCount(m_y); }
+
+    void log(std::ostream& os) const
+    {
+        if (size() > Details::g_logArrayFullLimit) {
+            os << "{x=";
+            Details::logArray(os, m_x);
+            os << ", y=";
+            Details::logArray(os, m_y);
+            os << "}";
+            return;
+        }
+        os << "{";
+        for (size_t i = 0; i < size(); ++i) {
+            if (i)
+                os << ", ";
+            get(i).log(os);
+        }
+        os << "}";
+    }
+
+    void writeTo(std::ostream& os) const
+    {
+        os << size() << "\n";
+        for (size_t i = 0; i < size(); ++i) {
+            Details::writeToImpl(os, m_x[i]);
+            os << " ";
+            Details::writeToImpl(os, m_y[i]);
+            os << "\n";
+        }
+    }
+
+    void readFrom(std::istream& is) &
+    {
+        size_t count = 0;
+        is >> count;
+        m_x.resize(count);
+        m_y.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            Details::readFromImpl(is, m_x[i]);
+            Details::readFromImpl(is, m_y[i]);
+        }
+    }
+
+    void mutate(std::mt19937_64& rng) & { Details::mutateArray(rng() % 2 ? m_x : m_y, rng); }
+};
+
+/// Packed bits in 64-bit words (bit i is bit i % 64 of word i / 64); bits past size() in the last word are always zero,
+/// so solutions can process whole words and count() is a plain popcount over words.
+/// Text format: size, then bits as one string of '0' and '1' characters.
+struct BitsetIO {
+    size_t                m_size = 0;
+    std::vector<uint64_t> m_words;
+
+    static BitsetIO fromString(std::string_view bits)
+    {
+        BitsetIO result;
+        result.resize(bits.size());
+        for (size_t i = 0; i < bits.size(); ++i) {
+            if (bits[i] == '1')
+                result.set(i);
+        }
+        return result;
+    }
+
+    size_t size() const { return m_size; }
+    void   resize(size_t size)
+    {
+        m_size = size;
+        m_words.resize((size + 63) / 64);
+        if (size % 64)
+            m_words.back() &= (uint64_t(1) << (size % 64)) - 1;
+    }
+
+    bool test(size_t index) const { return (m_words[index / 64] >> (index % 64)) & 1; }
+    void set(size_t index, bool value = true)
+    {
+        const uint64_t mask = uint64_t(1) << (index % 64);
+        if (value)
+            m_words[index / 64] |= mask;
+        else
+            m_words[index / 64] &= ~mask;
+    }
+
+    size_t count() const
+    {
+        size_t result = 0;
+        for (uint64_t word : m_words)
+            result += std::popcount(word);
+        return result;
+    }
+
+    std::string toString() const
+    {
+        std::string result(m_size, '0');
+        for (size_t i = 0; i < m_size; ++i) {
+            if (test(i))
+                result[i] = '1';
+        }
+        return result;
+    }
+
+    bool operator==(const BitsetIO& other) const { return m_size == other.m_size && Details::equalArrays(m_words, other.m_words); }
+
+    size_t elementCount() const { return m_size; }
+    size_t byteCount() const { return Details::arrayByteCount(m_words); }
+
+    uint32_t checksum() const { return Details::Kernels::checksum(std::span<const uint64_t>(m_words)); }
+
+    void log(std::ostream& os) const
+    {
+        if (m_size > Details::g_logArrayFullLimit) {
+            os << "{size=" << m_size << ", count=" << count() << ", xxh32=0x" << std::hex << checksum() << std::dec << "}";
+            return;
+        }
+        os << "{" << toString() << "}";
+    }
+
+    void writeTo(std::ostream& os) const
+    {
+        os << m_size << "\n";
+        Details::writeToImpl(os, toString());
+        os << "\n";
+    }
+
+    void readFrom(std::istream& is) &
+    {
+        size_t      size = 0;
+        std::string bits;
+        is >> size;
+        Details::readFromImpl(is, bits);
+        if (bits.size() != size) {
+            is.setstate(std::ios::failbit);
+            return;
+        }
+        *this = fromString(bits);
+    }
+
+    void mutate(std::mt19937_64& rng) &
+    {
+        if (!m_size)
+            return;
+        const size_t begin = Details::randomIndex(rng, m_size);
+        if (rng() % 2) {
+            set(begin, !test(begin));
+            return;
+        }
+        const size_t end   = begin + 1 + Details::randomIndex(rng, std::min<size_t>(m_size - begin, 256));
+        const bool   value = rng() % 2;
+        for (size_t i = begin; i < end; ++i)
+            set(i, value);
+    }
+};
+
+/// Multi-line text in one contiguous buffer, each line is followed by '\n'; lines and tokens are string_views into it,
+/// so reading a document does not allocate per line or per word. Offsets are stored instead of views to keep copies valid.
+/// Text format: line count, then lines as is (spaces inside lines are kept, "\r\n" is read as "\n").
+struct TextIO {
+    std::string         m_buffer;
+    std::vector<size_t> m_lineOffsets;
+
+    static TextIO fromString(std::string_view text)
+    {
+        TextIO result;
+        while (!text.empty()) {
+            const size_t end = std::min(text.find('\n'), text.size());
+            result.appendLine(text.substr(0, end));
+            text.remove_prefix(std::min(end + 1, text.size()));
+        }
+        return result;
+    }
+    static TextIO fromLines(std::initializer_list<std::string_view> lines)
+    {
+        TextIO result;
+        for (std::string_view line : lines)
+            result.appendLine(line);
+        return result;
+    }
+
+    size_t           lineCount() const { return m_lineOffsets.size(); }
+    std::string_view line(size_t index) const
+    {
+        const size_t end = index + 1 < m_lineOffsets.size() ? m_lineOffsets[index + 1] : m_buffer.size();
+        return std::string_view(m_buffer).substr(m_lineOffsets[index], end - 1 - m_lineOffsets[index]);
+    }
+
+    /// line must not contain '\n'.
+    void appendLine(std::string_view line)
+    {
+        m_lineOffsets.push_back(m_buffer.size());
+        m_buffer.append(line);
+        m_buffer += '\n';
+    }
+
+    /// Calls callback(std::string_view) for every whitespace-separated token of the text.
+    template<class Callback>
+    void forEachToken(Callback&& callback) const
+    {
+        const char* p   = m_buffer.data();
+        const char* end = p + m_buffer.size();
+        while (p != end) {
+            while (p != end && std::isspace(static_cast<unsigned char>(*p)))
+                ++p;
+            const char* start = p;
+            while (p != end && !std::isspace(static_cast<unsigned char>(*p)))
+                ++p;
+            if (p != start)
+                callback(std::string_view(start, p - start));
+        }
+    }
+
+    /// Lines are determined by buffer as each of them ends with '\n'.
+    bool operator==(const TextIO& other) const { return m_buffer == other.m_buffer; }
+
+    size_t elementCount() const { return m_lineOffsets.size(); }
+    size_t byteCount() const { return m_buffer.size() + Details::arrayByteCount(m_lineOffsets); }
+
+    uint32_t checksum() const { return Details::Kernels::checksumBytes((const unsigned char*) m_buffer.data(), m_buffer.size()); }
+
+    void log(std::ostream& os) const
+    {
+        if (m_buffer.size() > Details::g_logArrayFullLimit) {
+            os << "{lines=" << lineCount() << ", bytes=" << m_buffer.size() << ", xxh32=0x" << std::hex << checksum() << std::dec << "}";
+            return;
+        }
+        os << "{";
+        for (size_t i = 0; i < lineCount(); ++i)
+            os << (i ? ", " : "") << '"' << line(i) << '"';
+        os << "}";
+    }
+
+    void writeTo(std::ostream& os) const
+    {
+        os << lineCount() << "\n";
+        os.write(m_buffer.data(), std::streamsize(m_buffer.size()));
+    }
+
+    /// Rest of the stream is taken into m_buffer with bulk reads, then lines are found in one pass over it,
+    /// so TextIO must be the last value in its stream. Lines after the declared count are dropped.
+    void readFrom(std::istream& is) &
+    {
+        size_t count = 0;
+        if (!(is >> count))
+            return;
+        m_buffer.clear();
+        m_lineOffsets.clear();
+        m_lineOffsets.reserve(count);
+        std::streambuf* buf = is.rdbuf();
+        // rest of the line with count.
+        int skipped = buf->sbumpc();
+        while (skipped != EOF && skipped != '\n')
+            skipped = buf->sbumpc();
+
+        // plain files know their remaining size, so usually there is a single read; other streams are read in chunks.
+        size_t     chunk   = size_t(1) << 16;
+        const auto current = buf->pubseekoff(0, std::ios::cur, std::ios::in);
+        if (current != std::streampos(-1)) {
+            const auto end = buf->pubseekoff(0, std::ios::end, std::ios::in);
+            buf->pubseekpos(current, std::ios::in);
+            if (end != std::streampos(-1) && end > current)
+                chunk = std::max(chunk, size_t(end - current) + 1);
+        }
+        while (true) {
+            const size_t old = m_buffer.size();
+            m_buffer.resize(old + chunk);
+            const size_t got = size_t(buf->sgetn(m_buffer.data() + old, std::streamsize(chunk)));
+            m_buffer.resize(old + got);
+            if (got < chunk)
+                break;
+        }
+        if (!m_buffer.empty() && m_buffer.back() != '\n')
+            m_buffer += '\n';
+
+        // "\r\n" is shortened in place, so lines are moved back only after the first '\r'.
+        char*        data  = m_buffer.data();
+        const size_t size  = m_buffer.size();
+        size_t       write = 0;
+        for (size_t read = 0; read < size && m_lineOffsets.size() < count;) {
+            m_lineOffsets.push_back(write);
+            const char*  lineEnd = static_cast<const char*>(std::memchr(data + read, '\n', size - read));
+            const size_t next    = size_t(lineEnd - data) + 1;
+            size_t       length  = next - 1 - read;
+            if (length && data[read + length - 1] == '\r')
+                length--;
+            if (write != read)
+                std::memmove(data + write, data + read, length);
+            write += length;
+            data[write++] = '\n';
+            read          = next;
+        }
+        m_buffer.resize(write);
+        if (m_lineOffsets.size() < count)
+            is.setstate(std::ios::failbit | std::ios::eofbit);
+    }
+
+    /// Swaps or copies characters inside lines, line structure is kept.
+    void mutate(std::mt19937_64& rng) &
+    {
+        if (m_buffer.empty())
+            return;
+        const size_t i = Details::randomIndex(rng, m_buffer.size());
+        const size_t j = Details::randomIndex(rng, m_buffer.size());
+        if (m_buffer[i] == '\n' || m_buffer[j] == '\n')
+            return;
+        if (rng() % 2)
+            std::swap(m_buffer[i], m_buffer[j]);
+        else
+            m_buffer[i] = m_buffer[j];
+    }
 };
 
+/// Elements of matrix column (or any fixed-stride sequence) without copying.
 template<typename T>
+struct StridedView {
+    T*     m_data   = nullptr;
+    size_t m_stride = 0;
+    size_t m_size   = 0;
+
+    size_t size() const { return m_size; }
+    T&     operator[](size_t index) const { return m_data[index * m_stride]; }
+};
+
+/// Dense matrix in cache line aligned storage, elements are value-initialized.
+/// With tileSize == 0 layout is row-major and every row is padded to 64 bytes: row r starts at m_data[r * m_stride],
+/// so rows are contiguous aligned spans (row()), and columns are strided views (column()).
+/// With tileSize > 0 matrix is stored as tileSize x tileSize blocks, each block is contiguous and row-major inside,
+/// blocks are ordered row-major too; blocked algorithms (matrix multiplication, DP over cells) then work on tile().
+/// Padding is never written through accessors, so it stays value-initialized and storage can be compared as a whole.
+/// Text format: "rows cols", then every row on its own line.
+template<typename T, size_t tileSize = 0>
 struct MatrixIO {
-    size_t         m_rows = 0;
-    size_t         m_cols = 0;
-    std::vector<T> m_data;
+    static constexpr size_t g_rowAlignment = 64 % sizeof(T) == 0 ? std::max<size_t>(64 / sizeof(T), 1) : 1;
+
+    size_t                                           m_rows   = 0;
+    size_t                                           m_cols   = 0;
+    size_t                                           m_stride = 0; // padded row size, or tiles per row in tiled layout.
+    std::vector<T, Details::AlignedAllocator<T, 64>> m_data;
+
+    static constexpr MatrixIO fromRows(std::initializer_list<std::initializer_list<T>> rows)
+    {
+        MatrixIO result;
+        result.resize(rows.size(), rows.size() ? rows.begin()->size() : 0);
+        size_t i = 0;
+        for (const auto& row : rows) {
+            size_t j = 0;
+            for (const T& value : row)
+                result.get(i, j++) = value;
+            ++i;
+        }
+        return result;
+    }
+
+    /// Resets all elements to T().
+    constexpr void resize(size_t rows, size_t cols)
+    {
+        m_rows = rows;
+        m_cols = cols;
+        m_data.clear();
+        if constexpr (tileSize == 0) {
+            m_stride = (cols + g_rowAlignment - 1) / g_rowAlignment * g_rowAlignment;
+            m_data.resize(rows * m_stride);
+        } else {
+            m_stride = (cols + tileSize - 1) / tileSize;
+            m_data.resize((rows + tileSize - 1) / tileSize * m_stride * tileSize * tileSize);
+        }
+    }
+
+    constexpr size_t index(size_t row, size_t col) const
+    {
+        if constexpr (tileSize == 0)
+            return row * m_stride + col;
+        else
+            return ((row / tileSize) * m_stride + col / tileSize) * tileSize * tileSize + (row % tileSize) * tileSize + col % tileSize;
+    }
+
+    constexpr T  get(size_t row, size_t col) const& { return m_data[index(row, col)]; }
+    constexpr T& get(size_t row, size_t col) & { return m_data[index(row, col)]; }
+
+    std::span<T> row(size_t rowIndex) &
+        requires(tileSize == 0)
+    {
+        return { m_data.data() + rowIndex * m_stride, m_cols };
+    }
+    std::span<const T> row(size_t rowIndex) const&
+        requires(tileSize == 0)
+    {
+        return { m_data.data() + rowIndex * m_stride, m_cols };
+    }
+    StridedView<T> column(size_t colIndex) &
+        requires(tileSize == 0)
+    {
+        return { m_data.data() + colIndex, m_stride, m_rows };
+    }
+    StridedView<const T> column(size_t colIndex) const&
+        requires(tileSize == 0)
+    {
+        return { m_data.data() + colIndex, m_stride, m_rows };
+    }
+
+    /// Block (tileRow, tileCol) as tileSize * tileSize row-major elements; border tiles contain padding.
+    std::span<T> tile(size_t tileRow, size_t tileCol) &
+        requires(tileSize > 0)
+    {
+        return { m_data.data() + (tileRow * m_stride + tileCol) * tileSize * tileSize, tileSize * tileSize };
+    }
+    std::span<const T> tile(size_t tileRow, size_t tileCol) const&
+        requires(tileSize > 0)
+    {
+        return { m_data.data() + (tileRow * m_stride + tileCol) * tileSize * tileSize, tileSize * tileSize };
+    }
+
+    constexpr bool operator==(const MatrixIO& other) const
+    {
+        return m_rows == other.m_rows && m_cols == other.m_cols && Details::equalArrays(m_data, other.m_data);
+    }
 
-    T  get(size_t row, size_t col) const& { return m_data[row * m_cols + col]; }
-    T& get(size_t row, size_t col) & { return m_data[row * m_cols + col]; }
+    size_t elementCount() const { return m_rows * m_cols; }
+    size_t byteCount() const { return Details::arrayByteCount(m_data); }
 
-    bool operator==(const MatrixIO&) const = default;
+    /// Checksum of whole storage, including padding.
+    uint32_t checksum() const
+        requires Details::Kernels::Vectorizable<T>
+    {
+        return Details::Kernels::checksum(std::span<const T>(m_data.data(), m_data.size()));
+    }
 
     void log(std::ostream& os) const
     {
+        if constexpr (Details::Kernels::Vectorizable<T>) {
+            if (elementCount() > Details::g_logArrayFullLimit) {
+                os << "{rows=" << m_rows << ", cols=" << m_cols << ", xxh32=0x" << std::hex << checksum() << std::dec << "}";
+                return;
+            }
+        }
         os << m_rows << "x" << m_cols << "\n";
+        std::vector<T> values(m_cols);
         for (size_t i = 0; i < m_rows; ++i) {
-            Details::logArray(os, std::span<const T>(m_data.data() + i * m_cols, m_cols));
+            for (size_t j = 0; j < m_cols; ++j)
+                values[j] = get(i, j);
+            Details::logArray(os, values);
             os << "\n";
         }
     }
+
     void writeTo(std::ostream& os) const
     {
-        os << m_rows << m_cols << "\n";
-        for (auto&& row : m_data) {
-            for (auto&& cell : row) {
-                Details::writeToImpl(os, cell);
+        if constexpr (Details::Kernels::Vectorizable<T>) {
+            Details::NumberWriter writer(os);
+            writer.write(m_rows).write(' ').write(m_cols).write('\n');
+            for (size_t i = 0; i < m_rows; ++i) {
+                for (size_t j = 0; j < m_cols; ++j) {
+                    if (j)
+                        writer.write(' ');
+                    writer.write(get(i, j));
+                }
+                writer.write('\n');
+            }
+        } else {
+            os << m_rows << " " << m_cols << "\n";
+            for (size_t i = 0; i < m_rows; ++i) {
+                for (size_t j = 0; j < m_cols; ++j) {
+                    if (j)
+                        os << " ";
+                    Details::writeToImpl(os, get(i, j));
+                }
+                os << "\n";
+            }
+        }
+    }
+
+    void readFrom(std::istream& is) &
+    {
+        size_t rows = 0, cols = 0;
+        if (!(is >> rows >> cols))
+            return;
+        resize(rows, cols);
+        if constexpr (Details::Kernels::Vectorizable<T>) {
+            Details::NumberReader reader(is);
+            for (size_t i = 0; i < m_rows; ++i) {
+                if constexpr (tileSize == 0) {
+                    if (!reader.read(row(i)))
+                        return;
+                } else {
+                    for (size_t j = 0; j < m_cols; ++j) {
+                        if (!reader.read(get(i, j)))
+                            return;
+                    }
+                }
+            }
+        } else {
+            for (size_t i = 0; i < m_rows; ++i) {
+                for (size_t j = 0; j < m_cols; ++j)
+                    Details::readFromImpl(is, get(i, j));
+            }
+        }
+    }
+
+    /// Mutates part of one row, padding is not touched.
+    void mutate(std::mt19937_64& rng) &
+    {
+        if (!m_rows || !m_cols)
+            return;
+        const size_t i = Details::randomIndex(rng, m_rows);
+        if constexpr (tileSize == 0) {
+            Details::mutateArray(row(i), rng);
+        } else {
+            // row segment inside one tile is contiguous.
+            const size_t tileCol = Details::randomIndex(rng, m_stride);
+            const size_t size    = std::min(tileSize, m_cols - tileCol * tileSize);
+            Details::mutateArray(std::span<T>(m_data.data() + index(i, tileCol * tileSize), size), rng);
+        }
+    }
+};
+
+/// Directed graph in CSR layout: neighbors of vertex v are m_adjacency[m_offsets[v] .. m_offsets[v + 1]).
+/// Optional edge weights are stored in m_weights parallel to m_adjacency (empty for unweighted graph).
+/// Text format is edge list, it is converted to CSR once on load:
+/// <vertices> <edges> <weighted: 0/1>
+/// <from> <to> [weight]   - for each edge
+/// Undirected edge is written as two directed edges.
+template<Details::Kernels::Vectorizable W = int32_t>
+struct GraphIO {
+    struct Edge {
+        uint32_t m_from   = 0;
+        uint32_t m_to     = 0;
+        W        m_weight = 0;
+    };
+
+    std::vector<uint32_t> m_offsets; // vertexCount() + 1 elements.
+    std::vector<uint32_t> m_adjacency;
+    std::vector<W>        m_weights;
+
+    /// Edges of one vertex keep their relative order from the list.
+    static GraphIO fromEdges(size_t vertexCount, std::span<const Edge> edges, bool weighted)
+    {
+        GraphIO result;
+        result.m_offsets.assign(vertexCount + 1, 0);
+        for (const Edge& edge : edges) {
+            if (edge.m_from >= vertexCount || edge.m_to >= vertexCount)
+                throw std::runtime_error("GraphIO: edge vertex is out of range");
+            result.m_offsets[edge.m_from + 1]++;
+        }
+        for (size_t v = 0; v < vertexCount; ++v)
+            result.m_offsets[v + 1] += result.m_offsets[v];
+
+        std::vector<uint32_t> position(result.m_offsets.begin(), result.m_offsets.end() - 1);
+        result.m_adjacency.resize(edges.size());
+        if (weighted)
+            result.m_weights.resize(edges.size());
+        for (const Edge& edge : edges) {
+            const uint32_t index      = position[edge.m_from]++;
+            result.m_adjacency[index] = edge.m_to;
+            if (weighted)
+                result.m_weights[index] = edge.m_weight;
+        }
+        return result;
+    }
+    static GraphIO fromEdges(size_t vertexCount, std::initializer_list<Edge> edges, bool weighted = false)
+    {
+        return fromEdges(vertexCount, std::span<const Edge>(edges.begin(), edges.size()), weighted);
+    }
+
+    size_t vertexCount() const { return m_offsets.empty() ? 0 : m_offsets.size() - 1; }
+    size_t edgeCount() const { return m_adjacency.size(); }
+    bool   isWeighted() const { return !m_weights.empty(); }
+
+    std::span<const uint32_t> neighbors(size_t vertex) const
+    {
+        return std::span<const uint32_t>(m_adjacency.data() + m_offsets[vertex], m_offsets[vertex + 1] - m_offsets[vertex]);
+    }
+    std::span<const W> weights(size_t vertex) const
+    {
+        return std::span<const W>(m_weights.data() + m_offsets[vertex], m_offsets[vertex + 1] - m_offsets[vertex]);
+    }
+
+    bool operator==(const GraphIO& other) const
+    {
+        return Details::equalArrays(m_offsets, other.m_offsets) && Details::equalArrays(m_adjacency, other.m_adjacency)
+               && Details::equalArrays(m_weights, other.m_weights);
+    }
+
+    size_t elementCount() const { return edgeCount(); }
+    size_t byteCount() const { return Details::arrayByteCount(m_offsets) + Details::arrayByteCount(m_adjacency) + Details::arrayByteCount(m_weights); }
+
+    void log(std::ostream& os) const
+    {
+        if (edgeCount() > Details::g_logArrayFullLimit) {
+            os << "{vertices=" << vertexCount() << ", edges=" << edgeCount() << ", adjacency xxh32=0x" << std::hex
+               << Details::Kernels::checksum(std::span<const uint32_t>(m_adjacency));
+            if (isWeighted())
+                os << ", weights xxh32=0x" << Details::Kernels::checksum(std::span<const W>(m_weights));
+            os << std::dec << "}";
+            return;
+        }
+        os << "V=" << vertexCount() << ", E=" << edgeCount() << "\n";
+        for (size_t v = 0; v < vertexCount(); ++v) {
+            if (m_offsets[v] == m_offsets[v + 1])
+                continue;
+            os << v << " -> ";
+            Details::logArray(os, neighbors(v));
+            if (isWeighted()) {
+                os << ", weights=";
+                Details::logArray(os, weights(v));
             }
             os << "\n";
         }
     }
 
+    void writeTo(std::ostream& os) const
+    {
+        Details::NumberWriter writer(os);
+        writer.write(vertexCount()).write(' ').write(edgeCount()).write(' ').write(int(isWeighted())).write('\n');
+        for (size_t v = 0; v < vertexCount(); ++v) {
+            for (uint32_t i = m_offsets[v]; i < m_offsets[v + 1]; ++i) {
+                writer.write(v).write(' ').write(m_adjacency[i]);
+                if (isWeighted())
+                    writer.write(' ').write(m_weights[i]);
+                writer.write('\n');
+            }
+        }
+    }
+
     void readFrom(std::istream& is) &
     {
-        is >> m_rows >> m_cols;
-        m_data.resize(m_rows * m_cols);
-        for (size_t i = 0; i < m_rows; ++i) {
-            for (size_t j = 0; j < m_cols; ++j) {
-                Details::readFromImpl(is, m_data[i * m_cols + j]);
+        Details::NumberReader reader(is);
+        size_t                vertexCount = 0, edgeCount = 0;
+        int                   weighted    = 0;
+        if (!reader.read(vertexCount) || !reader.read(edgeCount) || !reader.read(weighted))
+            return;
+        std::vector<Edge> edges(edgeCount);
+        for (Edge& edge : edges) {
+            if (!reader.read(edge.m_from) || !reader.read(edge.m_to) || (weighted && !reader.read(edge.m_weight)))
+                return;
+        }
+        *this = fromEdges(vertexCount, edges, weighted);
+    }
+
+    /// Keeps vertex and edge count; changes edge targets or weights.
+    void mutate(std::mt19937_64& rng) &
+    {
+        if (m_adjacency.empty())
+            return;
+        if (isWeighted() && rng() % 2) {
+            Details::mutateArray(m_weights, rng);
+            return;
+        }
+        const size_t index = Details::randomIndex(rng, m_adjacency.size());
+        if (rng() % 2)
+            m_adjacency[index] = static_cast<uint32_t>(Details::randomIndex(rng, vertexCount()));
+        else
+            m_adjacency[index] = m_adjacency[Details::randomIndex(rng, m_adjacency.size())];
+    }
+};
+
+/// Sparse matrix in CSR layout: row r has non-zero values m_values[m_rowOffsets[r] .. m_rowOffsets[r + 1]),
+/// their columns are in m_columns, sorted ascending within a row.
+/// Text format is COO triplets in any order, they are converted to CSR once on load (duplicate entries are summed):
+/// <rows> <cols> <non-zero count>
+/// <row> <col> <value>   - for each non-zero
+template<Details::Kernels::Vectorizable T>
+struct SparseMatrixIO {
+    struct Triplet {
+        uint32_t m_row   = 0;
+        uint32_t m_col   = 0;
+        T        m_value = 0;
+    };
+
+    size_t                m_rows = 0;
+    size_t                m_cols = 0;
+    std::vector<uint32_t> m_rowOffsets; // m_rows + 1 elements.
+    std::vector<uint32_t> m_columns;
+    std::vector<T>        m_values;
+
+    static SparseMatrixIO fromTriplets(size_t rows, size_t cols, std::span<const Triplet> triplets)
+    {
+        SparseMatrixIO result;
+        result.m_rows = rows;
+        result.m_cols = cols;
+        result.m_rowOffsets.assign(rows + 1, 0);
+        for (const Triplet& triplet : triplets) {
+            if (triplet.m_row >= rows || triplet.m_col >= cols)
+                throw std::runtime_error("SparseMatrixIO: element position is out of range");
+            result.m_rowOffsets[triplet.m_row + 1]++;
+        }
+        for (size_t r = 0; r < rows; ++r)
+            result.m_rowOffsets[r + 1] += result.m_rowOffsets[r];
+
+        std::vector<uint32_t> position(result.m_rowOffsets.begin(), result.m_rowOffsets.end() - 1);
+        std::vector<Triplet>  sorted(triplets.size());
+        for (const Triplet& triplet : triplets)
+            sorted[position[triplet.m_row]++] = triplet;
+
+        result.m_columns.reserve(sorted.size());
+        result.m_values.reserve(sorted.size());
+        for (size_t r = 0; r < rows; ++r) {
+            const auto begin = sorted.begin() + result.m_rowOffsets[r];
+            const auto end   = sorted.begin() + result.m_rowOffsets[r + 1];
+            std::stable_sort(begin, end, [](const Triplet& left, const Triplet& right) { return left.m_col < right.m_col; });
+            result.m_rowOffsets[r] = static_cast<uint32_t>(result.m_columns.size());
+            for (auto it = begin; it != end; ++it) {
+                if (it != begin && it->m_col == result.m_columns.back()) {
+                    result.m_values.back() += it->m_value;
+                    continue;
+                }
+                result.m_columns.push_back(it->m_col);
+                result.m_values.push_back(it->m_value);
+            }
+        }
+        result.m_rowOffsets[rows] = static_cast<uint32_t>(result.m_columns.size());
+        return result;
+    }
+    static SparseMatrixIO fromTriplets(size_t rows, size_t cols, std::initializer_list<Triplet> triplets)
+    {
+        return fromTriplets(rows, cols, std::span<const Triplet>(triplets.begin(), triplets.size()));
+    }
+
+    size_t nonZeroCount() const { return m_values.size(); }
+
+    std::span<const uint32_t> rowColumns(size_t row) const
+    {
+        return std::span<const uint32_t>(m_columns.data() + m_rowOffsets[row], m_rowOffsets[row + 1] - m_rowOffsets[row]);
+    }
+    std::span<const T> rowValues(size_t row) const
+    {
+        return std::span<const T>(m_values.data() + m_rowOffsets[row], m_rowOffsets[row + 1] - m_rowOffsets[row]);
+    }
+
+    /// Binary search within a row; returns 0 for elements that are not stored.
+    T get(size_t row, size_t col) const
+    {
+        const auto columns = rowColumns(row);
+        const auto it      = std::lower_bound(columns.begin(), columns.end(), col);
+        return it != columns.end() && *it == col ? m_values[m_rowOffsets[row] + (it - columns.begin())] : T(0);
+    }
+
+    bool operator==(const SparseMatrixIO& other) const
+    {
+        return m_rows == other.m_rows && m_cols == other.m_cols && Details::equalArrays(m_rowOffsets, other.m_rowOffsets)
+               && Details::equalArrays(m_columns, other.m_columns) && Details::equalArrays(m_values, other.m_values);
+    }
+
+    size_t elementCount() const { return nonZeroCount(); }
+    size_t byteCount() const { return Details::arrayByteCount(m_rowOffsets) + Details::arrayByteCount(m_columns) + Details::arrayByteCount(m_values); }
+
+    uint32_t checksum() const { return Details::Kernels::checksum(std::span<const T>(m_values)); }
+
+    void log(std::ostream& os) const
+    {
+        os << m_rows << "x" << m_cols << ", nnz=" << nonZeroCount();
+        if (nonZeroCount() > Details::g_logArrayFullLimit) {
+            os << ", columns xxh32=0x" << std::hex << Details::Kernels::checksum(std::span<const uint32_t>(m_columns));
+            os << ", values xxh32=0x" << checksum() << std::dec;
+            return;
+        }
+        os << "\n";
+        for (size_t r = 0; r < m_rows; ++r) {
+            if (m_rowOffsets[r] == m_rowOffsets[r + 1])
+                continue;
+            os << r << ": ";
+            for (uint32_t i = m_rowOffsets[r]; i < m_rowOffsets[r + 1]; ++i) {
+                if (i != m_rowOffsets[r])
+                    os << ", ";
+                os << m_columns[i] << "=";
+                Details::logValue(os, m_values[i]);
             }
+            os << "\n";
         }
     }
+
+    void writeTo(std::ostream& os) const
+    {
+        Details::NumberWriter writer(os);
+        writer.write(m_rows).write(' ').write(m_cols).write(' ').write(nonZeroCount()).write('\n');
+        for (size_t r = 0; r < m_rows; ++r) {
+            for (uint32_t i = m_rowOffsets[r]; i < m_rowOffsets[r + 1]; ++i)
+                writer.write(r).write(' ').write(m_columns[i]).write(' ').write(m_values[i]).write('\n');
+        }
+    }
+
+    void readFrom(std::istream& is) &
+    {
+        Details::NumberReader reader(is);
+        size_t                rows = 0, cols = 0, count = 0;
+        if (!reader.read(rows) || !reader.read(cols) || !reader.read(count))
+            return;
+        std::vector<Triplet> triplets(count);
+        for (Triplet& triplet : triplets) {
+            if (!reader.read(triplet.m_row) || !reader.read(triplet.m_col) || !reader.read(triplet.m_value))
+                return;
+        }
+        *this = fromTriplets(rows, cols, triplets);
+    }
+
+    /// Keeps sparsity pattern, changes values only.
+    void mutate(std::mt19937_64& rng) & { Details::mutateArray(m_values, rng); }
 };
 
 template<class InputTypeT, class OutputTypeT>
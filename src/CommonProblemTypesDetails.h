@@ -5,14 +5,24 @@
  */
 #pragma once
 
+#include "CommonProblemTypesKernels.h"
+
 #include <algorithm>
+#include <cctype>
+#include <charconv>
 #include <climits>
 #include <concepts>
 #include <cstdint>
+#include <functional>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <new>
+#include <random>
 #include <span>
 #include <sstream>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace CommonTypes::Details {
@@ -102,7 +112,10 @@ inline void readFromImpl(std::istream& is, T& value)
     value.readFrom(is);
 }
 
-/// Print integer array as {1, -2, 3}
+/// Values of bitset, text, matrix, graph and sparse matrix types bigger than this are logged as summary.
+constexpr size_t g_logArrayFullLimit = 1024;
+
+/// Print integer array as {1, -2, 3}; arrays are always printed in full, so failure log shows what differs.
 template<typename T>
 inline void logArray(std::ostream& os, const std::span<const T>& values)
 {
@@ -125,4 +138,304 @@ inline void logArray(std::ostream& os, const std::vector<T>& values)
     return logArray(os, std::span<const T>(values.data(), values.size()));
 }
 
+/// Same as l == r, but uses vectorized comparison for numeric arrays (except in constant evaluation).
+template<typename T, typename Alloc>
+constexpr bool equalArrays(const std::vector<T, Alloc>& l, const std::vector<T, Alloc>& r)
+{
+    if (std::is_constant_evaluated())
+        return l == r;
+    if constexpr (Kernels::Vectorizable<T>)
+        return Kernels::equal(std::span<const T>(l.data(), l.size()), std::span<const T>(r.data(), r.size()));
+    else
+        return l == r;
+}
+
+template<class P>
+concept Mutable = requires(P p, std::mt19937_64& rng) {
+                      requires std::same_as<decltype(p.mutate(rng)), void>;
+                  };
+
+/// Random index in [0, size), size must not be zero.
+inline size_t randomIndex(std::mt19937_64& rng, size_t size)
+{
+    return static_cast<size_t>(rng() % size);
+}
+
+/// Small change of a value that keeps it valid for its type (no overflow).
+template<Numeric T>
+inline void mutateValue(T& value, std::mt19937_64& rng)
+{
+    using Limits = std::numeric_limits<T>;
+    if constexpr (std::same_as<T, bool>) {
+        value = !value;
+    } else if constexpr (std::floating_point<T>) {
+        switch (rng() % 3) {
+            case 0:
+                value += 1;
+                break;
+            case 1:
+                value -= 1;
+                break;
+            default:
+                value = value / 2;
+                break;
+        }
+    } else {
+        switch (rng() % 4) {
+            case 0:
+                if (value < Limits::max())
+                    ++value;
+                break;
+            case 1:
+                if (value > Limits::min())
+                    --value;
+                break;
+            case 2:
+                value = value / 2;
+                break;
+            default:
+                if (value <= Limits::max() / 2 && value >= Limits::min() / 2)
+                    value = value * 2;
+                break;
+        }
+    }
+}
+inline void mutateValue(std::string& value, std::mt19937_64& rng)
+{
+    if (value.empty())
+        return;
+    const size_t i = randomIndex(rng, value.size());
+    const size_t j = randomIndex(rng, value.size());
+    if (rng() % 2)
+        std::swap(value[i], value[j]);
+    else
+        value[i] = value[j];
+}
+template<Mutable T>
+inline void mutateValue(T& value, std::mt19937_64& rng)
+{
+    value.mutate(rng);
+}
+
+/// Random size-preserving change of array, targeting typical worst cases: equal keys, sorted and reversed runs.
+/// Works with vectors and with spans over part of a bigger storage.
+template<typename Range>
+inline void mutateArray(Range&& values, std::mt19937_64& rng)
+{
+    using T = typename std::remove_cvref_t<Range>::value_type;
+    if (values.empty())
+        return;
+    constexpr bool sortable = std::totally_ordered<T> && !std::same_as<T, bool>;
+
+    const size_t size  = values.size();
+    const size_t begin = randomIndex(rng, size);
+    const size_t end   = begin + 1 + randomIndex(rng, size - begin);
+    const auto   first = values.begin() + begin;
+    const auto   last  = values.begin() + end;
+    switch (rng() % 7) {
+        case 0:
+            values[begin] = values[randomIndex(rng, size)];
+            break;
+        case 1:
+            std::iter_swap(first, values.begin() + randomIndex(rng, size));
+            break;
+        case 2:
+            std::fill(first, last, values[randomIndex(rng, size)]);
+            break;
+        case 3:
+            std::reverse(first, last);
+            break;
+        case 4:
+            if constexpr (sortable)
+                std::sort(first, last);
+            break;
+        case 5:
+            if constexpr (sortable)
+                std::sort(first, last, std::greater<T>());
+            break;
+        default:
+            if constexpr (std::same_as<T, bool>) {
+                values[begin] = !values[begin];
+            } else {
+                mutateValue(values[begin], rng);
+            }
+            break;
+    }
+}
+
+/// Reads whitespace separated numbers directly from stream buffer, without formatted input overhead for every value.
+/// On malformed number failbit is set on the stream and all further reads fail.
+class NumberReader {
+public:
+    explicit NumberReader(std::istream& is)
+        : m_is(is)
+        , m_buf(is.rdbuf())
+    {
+    }
+
+    template<Kernels::Vectorizable T>
+    bool read(T& value)
+    {
+        if (!m_is)
+            return false;
+        int c = m_buf->sgetc();
+        while (c != EOF && std::isspace(c))
+            c = m_buf->snextc();
+
+        char   token[80];
+        size_t length = 0;
+        while (c != EOF && !std::isspace(c) && length < sizeof(token)) {
+            token[length++] = static_cast<char>(c);
+            c               = m_buf->snextc();
+        }
+        if (c == EOF)
+            m_is.setstate(std::ios::eofbit);
+
+        const char* begin = token;
+        if (length > 1 && token[0] == '+')
+            ++begin;
+        const auto [end, ec] = std::from_chars(begin, token + length, value);
+        if (!length || length == sizeof(token) || ec != std::errc() || end != token + length) {
+            m_is.setstate(std::ios::failbit);
+            return false;
+        }
+        return true;
+    }
+
+    template<Kernels::Vectorizable T>
+    bool read(std::span<T> values)
+    {
+        for (T& value : values) {
+            if (!read(value))
+                return false;
+        }
+        return true;
+    }
+
+private:
+    std::istream&   m_is;
+    std::streambuf* m_buf;
+};
+
+/// Formats numbers into internal buffer and writes it to stream in big chunks.
+/// Floating point values are written in shortest form that reads back to exactly the same value.
+class NumberWriter {
+public:
+    explicit NumberWriter(std::ostream& os)
+        : m_os(os)
+    {
+    }
+    ~NumberWriter() { flush(); }
+
+    template<Kernels::Vectorizable T>
+    NumberWriter& write(T value)
+    {
+        if (m_size + 64 > sizeof(m_buffer))
+            flush();
+        m_size = std::to_chars(m_buffer + m_size, m_buffer + sizeof(m_buffer), value).ptr - m_buffer;
+        return *this;
+    }
+
+    NumberWriter& write(char separator)
+    {
+        if (m_size == sizeof(m_buffer))
+            flush();
+        m_buffer[m_size++] = separator;
+        return *this;
+    }
+
+    /// Writes values separated by space.
+    template<Kernels::Vectorizable T>
+    NumberWriter& write(std::span<const T> values)
+    {
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (i)
+                write(' ');
+            write(values[i]);
+        }
+        return *this;
+    }
+
+    void flush()
+    {
+        m_os.write(m_buffer, static_cast<std::streamsize>(m_size));
+        m_size = 0;
+    }
+
+private:
+    std::ostream& m_os;
+    char          m_buffer[16384];
+    size_t        m_size = 0;
+};
+
+/// Allocator with cache line aligned storage (goes through aligned operator new, so CustomAlloc counts it).
+/// In constant evaluation it falls back to std::allocator, so containers using it stay constexpr-capable.
+template<typename T, size_t alignment = 64>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template<typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, alignment>;
+    };
+
+    static constexpr std::align_val_t g_alignment{ std::max(alignment, alignof(T)) };
+
+    constexpr AlignedAllocator() noexcept = default;
+    template<typename U>
+    constexpr AlignedAllocator(const AlignedAllocator<U, alignment>&) noexcept
+    {
+    }
+
+    constexpr T* allocate(size_t count)
+    {
+        if (std::is_constant_evaluated())
+            return std::allocator<T>().allocate(count);
+        return static_cast<T*>(::operator new(count * sizeof(T), g_alignment));
+    }
+    constexpr void deallocate(T* p, size_t count) noexcept
+    {
+        if (std::is_constant_evaluated())
+            std::allocator<T>().deallocate(p, count);
+        else
+            ::operator delete(p, g_alignment);
+    }
+
+    template<typename U>
+    constexpr bool operator==(const AlignedAllocator<U, alignment>&) const noexcept
+    {
+        return true;
+    }
+};
+
+template<class P>
+concept HasByteCount = requires(const P& p) {
+                           { p.byteCount() } -> std::convertible_to<size_t>;
+                       };
+
+/// Size of payload data, used for throughput metrics: strings and numeric arrays are counted by content.
+template<typename T>
+inline size_t byteCountOf(const T& value)
+{
+    if constexpr (HasByteCount<T>)
+        return value.byteCount();
+    else if constexpr (std::same_as<T, std::string>)
+        return value.size();
+    else
+        return sizeof(T);
+}
+
+template<typename T, typename Alloc>
+inline size_t arrayByteCount(const std::vector<T, Alloc>& values)
+{
+    if constexpr (Numeric<T>) {
+        return values.size() * sizeof(T);
+    } else {
+        size_t result = 0;
+        for (const T& value : values)
+            result += byteCountOf(value);
+        return result;
+    }
+}
+
 }
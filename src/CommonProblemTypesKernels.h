@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2025 Smirnov Vladimir / mapron1@gmail.com
+ * SPDX-License-Identifier: CC0-1.0
+ * See LICENSE file for details.
+ */
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CONTEST_CHECKER_KERNELS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+/// Vectorized helpers for bulk numeric data: comparison, checksum and min/max.
+/// Every kernel has a scalar reference path with exactly the same result, SIMD is only used when available.
+namespace CommonTypes::Details::Kernels {
+
+/// Types that can be processed as flat array (std::vector<bool> is excluded as it is not contiguous).
+template<class T>
+concept Vectorizable = (std::integral<T> || std::floating_point<T>) && !std::same_as<T, bool>;
+
+namespace Impl {
+constexpr uint32_t g_prime1 = 0x9E3779B1U;
+constexpr uint32_t g_prime2 = 0x85EBCA77U;
+constexpr uint32_t g_prime3 = 0xC2B2AE3DU;
+constexpr uint32_t g_prime4 = 0x27D4EB2FU;
+constexpr uint32_t g_prime5 = 0x165667B1U;
+
+inline uint32_t read32(const unsigned char* p)
+{
+    uint32_t result;
+    std::memcpy(&result, p, sizeof(result));
+    return result;
+}
+
+inline uint32_t round32(uint32_t acc, uint32_t input)
+{
+    acc += input * g_prime2;
+    acc = std::rotl(acc, 13);
+    return acc * g_prime1;
+}
+
+#ifdef CONTEST_CHECKER_KERNELS_SSE2
+/// 32-bit lane multiply; SSE2 has only 32x32->64 unsigned multiply on even lanes.
+inline __m128i mullo32(__m128i a, __m128i b)
+{
+    const __m128i even = _mm_mul_epu32(a, b);
+    const __m128i odd  = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+inline __m128i round32x4(__m128i acc, __m128i input, __m128i prime1, __m128i prime2)
+{
+    acc = _mm_add_epi32(acc, mullo32(input, prime2));
+    acc = _mm_or_si128(_mm_slli_epi32(acc, 13), _mm_srli_epi32(acc, 32 - 13));
+    return mullo32(acc, prime1);
+}
+
+inline bool equalBytes(const unsigned char* l, const unsigned char* r, size_t size)
+{
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        __m128i diff = _mm_xor_si128(_mm_loadu_si128((const __m128i*) (l + i)), _mm_loadu_si128((const __m128i*) (r + i)));
+        diff         = _mm_or_si128(diff, _mm_xor_si128(_mm_loadu_si128((const __m128i*) (l + i + 16)), _mm_loadu_si128((const __m128i*) (r + i + 16))));
+        diff         = _mm_or_si128(diff, _mm_xor_si128(_mm_loadu_si128((const __m128i*) (l + i + 32)), _mm_loadu_si128((const __m128i*) (r + i + 32))));
+        diff         = _mm_or_si128(diff, _mm_xor_si128(_mm_loadu_si128((const __m128i*) (l + i + 48)), _mm_loadu_si128((const __m128i*) (r + i + 48))));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(diff, _mm_setzero_si128())) != 0xFFFF)
+            return false;
+    }
+    for (; i + 16 <= size; i += 16) {
+        const __m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*) (l + i)), _mm_loadu_si128((const __m128i*) (r + i)));
+        if (_mm_movemask_epi8(eq) != 0xFFFF)
+            return false;
+    }
+    return std::memcmp(l + i, r + i, size - i) == 0;
+}
+#endif
+
+}
+
+/// Element-wise equality with the same semantics as operator== (so for floating point NaN != NaN and -0.0 == 0.0).
+template<Vectorizable T>
+inline bool equal(std::span<const T> l, std::span<const T> r)
+{
+    if (l.size() != r.size())
+        return false;
+    if constexpr (std::integral<T>) {
+        // integers are equal if and only if their object representations are equal.
+#ifdef CONTEST_CHECKER_KERNELS_SSE2
+        return Impl::equalBytes((const unsigned char*) l.data(), (const unsigned char*) r.data(), l.size_bytes());
+#else
+        return l.empty() || std::memcmp(l.data(), r.data(), l.size_bytes()) == 0;
+#endif
+    } else {
+        size_t i = 0;
+#ifdef CONTEST_CHECKER_KERNELS_SSE2
+        if constexpr (std::same_as<T, float>) {
+            for (; i + 4 <= l.size(); i += 4) {
+                if (_mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(l.data() + i), _mm_loadu_ps(r.data() + i))) != 0xF)
+                    return false;
+            }
+        } else if constexpr (std::same_as<T, double>) {
+            for (; i + 2 <= l.size(); i += 2) {
+                if (_mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(l.data() + i), _mm_loadu_pd(r.data() + i))) != 0x3)
+                    return false;
+            }
+        }
+#endif
+        for (; i < l.size(); ++i) {
+            if (!(l[i] == r[i]))
+                return false;
+        }
+        return true;
+    }
+}
+
+/// xxHash32 of raw bytes (seed 0). Result is the same as reference XXH32 implementation.
+inline uint32_t checksumBytes(const unsigned char* data, size_t size)
+{
+    using namespace Impl;
+    const unsigned char* p   = data;
+    const unsigned char* end = data + size;
+    uint32_t             h   = 0;
+    if (size >= 16) {
+#ifdef CONTEST_CHECKER_KERNELS_SSE2
+        const __m128i prime1 = _mm_set1_epi32((int) g_prime1);
+        const __m128i prime2 = _mm_set1_epi32((int) g_prime2);
+        __m128i       acc    = _mm_setr_epi32((int) (g_prime1 + g_prime2), (int) g_prime2, 0, (int) (0U - g_prime1));
+        for (; p + 16 <= end; p += 16)
+            acc = round32x4(acc, _mm_loadu_si128((const __m128i*) p), prime1, prime2);
+        uint32_t v[4];
+        _mm_storeu_si128((__m128i*) v, acc);
+#else
+        uint32_t v[4] = { g_prime1 + g_prime2, g_prime2, 0, 0U - g_prime1 };
+        for (; p + 16 <= end; p += 16) {
+            v[0] = round32(v[0], read32(p));
+            v[1] = round32(v[1], read32(p + 4));
+            v[2] = round32(v[2], read32(p + 8));
+            v[3] = round32(v[3], read32(p + 12));
+        }
+#endif
+        h = std::rotl(v[0], 1) + std::rotl(v[1], 7) + std::rotl(v[2], 12) + std::rotl(v[3], 18);
+    } else {
+        h = g_prime5;
+    }
+    h += (uint32_t) size;
+    for (; p + 4 <= end; p += 4) {
+        h += read32(p) * g_prime3;
+        h = std::rotl(h, 17) * g_prime4;
+    }
+    for (; p < end; ++p) {
+        h += (*p) * g_prime5;
+        h = std::rotl(h, 11) * g_prime1;
+    }
+    h ^= h >> 15;
+    h *= g_prime2;
+    h ^= h >> 13;
+    h *= g_prime3;
+    h ^= h >> 16;
+    return h;
+}
+
+/// Checksum of object representation; note that for floating point -0.0 and 0.0 have different checksums.
+template<Vectorizable T>
+inline uint32_t checksum(std::span<const T> values)
+{
+    return checksumBytes((const unsigned char*) values.data(), values.size_bytes());
+}
+
+/// Returns {min, max} pair; values must not be empty. For floating point NaNs are ignored unless all values are NaN.
+template<Vectorizable T>
+inline std::pair<T, T> minMax(std::span<const T> values)
+{
+    size_t i = 0;
+    T      minValue{};
+    T      maxValue{};
+    bool   hasValue = false;
+#ifdef CONTEST_CHECKER_KERNELS_SSE2
+    if constexpr (std::same_as<T, int32_t>) {
+        if (values.size() >= 4) {
+            __m128i vmin = _mm_loadu_si128((const __m128i*) values.data());
+            __m128i vmax = vmin;
+            for (i = 4; i + 4 <= values.size(); i += 4) {
+                const __m128i v      = _mm_loadu_si128((const __m128i*) (values.data() + i));
+                const __m128i less   = _mm_cmplt_epi32(v, vmin);
+                const __m128i bigger = _mm_cmpgt_epi32(v, vmax);
+                vmin                 = _mm_or_si128(_mm_and_si128(less, v), _mm_andnot_si128(less, vmin));
+                vmax                 = _mm_or_si128(_mm_and_si128(bigger, v), _mm_andnot_si128(bigger, vmax));
+            }
+            int32_t mins[4], maxs[4];
+            _mm_storeu_si128((__m128i*) mins, vmin);
+            _mm_storeu_si128((__m128i*) maxs, vmax);
+            minValue = *std::min_element(mins, mins + 4);
+            maxValue = *std::max_element(maxs, maxs + 4);
+            hasValue = true;
+        }
+    } else if constexpr (std::same_as<T, int16_t>) {
+        if (values.size() >= 8) {
+            __m128i vmin = _mm_loadu_si128((const __m128i*) values.data());
+            __m128i vmax = vmin;
+            for (i = 8; i + 8 <= values.size(); i += 8) {
+                const __m128i v = _mm_loadu_si128((const __m128i*) (values.data() + i));
+                vmin            = _mm_min_epi16(vmin, v);
+                vmax            = _mm_max_epi16(vmax, v);
+            }
+            int16_t mins[8], maxs[8];
+            _mm_storeu_si128((__m128i*) mins, vmin);
+            _mm_storeu_si128((__m128i*) maxs, vmax);
+            minValue = *std::min_element(mins, mins + 8);
+            maxValue = *std::max_element(maxs, maxs + 8);
+            hasValue = true;
+        }
+    }
+#endif
+    for (; i < values.size(); ++i) {
+        const T value = values[i];
+        if constexpr (std::floating_point<T>) {
+            if (value != value)
+                continue;
+        }
+        if (!hasValue) {
+            minValue = maxValue = value;
+            hasValue            = true;
+            continue;
+        }
+        minValue = std::min(minValue, value);
+        maxValue = std::max(maxValue, value);
+    }
+    if (!hasValue && !values.empty())
+        return { values[0], values[0] };
+    return { minValue, maxValue };
+}
+
+}
@@ -5,11 +5,36 @@
  */
 #pragma once
 
+#include "BenchmarkHistory.h"
+#include "Calibration.h"
+#include "CustomAlloc.h"
 #include "CommandLine.h"
 #include "CommonProblemTypes.h"
+#include "ParallelExecutor.h"
 #include "PerformanceCounter.h"
+#include "PluginApi.h"
+#include "Profiler.h"
+#include "ResultCache.h"
+#include "SolutionPhases.h"
+#include "StreamingCompare.h"
+#include "TestArena.h"
+#include "TestFiles.h"
+#include "Tracing.h"
 
 #include <algorithm>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <latch>
+#include <limits>
+#include <map>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <type_traits>
+#include <typeinfo>
 
 /// Non-heap allocating linked list of funtion pointers.
 /// This list is global for process.
@@ -18,14 +43,16 @@ struct CallbackList {
     using Callback             = void (*)(void);
     using CallbackNodePtr      = CallbackList*;
     Callback        m_callback = nullptr;
+    const char*     m_name     = nullptr; // shown in trace.
     CallbackNodePtr m_next     = nullptr;
 
     CallbackList() = default;
-    explicit CallbackList(Callback cb)
+    explicit CallbackList(Callback cb, const char* name = "callback")
     {
         CallbackNodePtr& back = getBack();
         back->m_next          = this;
         back->m_callback      = cb;
+        back->m_name          = name;
         back                  = this;
     }
 
@@ -43,8 +70,10 @@ struct CallbackList {
     {
         CallbackNodePtr node = getFront();
         while (node->m_next) {
-            if (node->m_callback)
+            if (node->m_callback) {
+                Tracing::Span span(node->m_name, "init");
                 node->m_callback();
+            }
             node = node->m_next;
         }
     }
@@ -63,10 +92,31 @@ struct CompileTimeLiteral {
 
 /// Stores all run() functions for every problem.
 struct AbstractProblemData {
-    using Callback = bool (*)(const CLIParams& params);
-    struct RunnerDesc {
-        Callback         m_cb;
+    using Callback             = bool (*)(const CLIParams& params);
+    using PluginSolutionAccept = bool (*)(std::string_view          signature,
+                                          std::string_view          abiKey,
+                                          PluginApi::GenericFunction function,
+                                          std::string_view          implName,
+                                          std::string_view          studentName,
+                                          uint64_t                  pluginId);
+    using PluginSolutionRemove = void (*)(uint64_t pluginId);
+
+    /// Smallest piece of work that can be run separately: one solution on one test source.
+    struct WorkUnit {
         std::string_view m_problemName;
+        std::string_view m_studentName;
+        std::string_view m_implName;
+        std::string_view m_sourceName;
+    };
+    using WorkUnitList  = std::vector<WorkUnit>;
+    using ListWorkUnits = void (*)(const CLIParams& params, WorkUnitList& units);
+
+    struct RunnerDesc {
+        Callback             m_cb;
+        PluginSolutionAccept m_acceptPluginSolution;
+        PluginSolutionRemove m_removePluginSolutions;
+        ListWorkUnits        m_listWorkUnits;
+        std::string_view     m_problemName;
     };
 
     using ProblemDescList = std::vector<RunnerDesc>;
@@ -76,15 +126,50 @@ struct AbstractProblemData {
         static ProblemDescList list;
         return list;
     }
-    static void registerRunner(Callback callback, std::string_view name) { getProblemRunners().push_back({ callback, name }); }
 
-    static const ProblemDescList& getSortedProblemRunners()
+    /// List is kept sorted by problem name.
+    template<class Problem>
+    static void registerProblem()
     {
         auto& allDesc = getProblemRunners();
-        std::sort(allDesc.begin(), allDesc.end(), [](const RunnerDesc& l, const RunnerDesc& r) {
-            return l.m_problemName < r.m_problemName;
+        auto  it      = std::upper_bound(allDesc.begin(), allDesc.end(), Problem::s_problemName, [](std::string_view name, const RunnerDesc& desc) {
+            return name < desc.m_problemName;
         });
-        return allDesc;
+        allDesc.insert(it, { Problem::run, Problem::acceptPluginSolution, Problem::removePluginSolutions, Problem::listWorkUnits, Problem::s_problemName });
+    }
+
+    static const RunnerDesc* findProblemRunner(std::string_view name)
+    {
+        for (const RunnerDesc& desc : getProblemRunners()) {
+            if (desc.m_problemName == name)
+                return &desc;
+        }
+        return nullptr;
+    }
+
+    static const ProblemDescList& getSortedProblemRunners() { return getProblemRunners(); }
+
+    /// All work units passing filters, in the same order as runAll() would execute them.
+    static WorkUnitList listAllWorkUnits(const CLIParams& params)
+    {
+        WorkUnitList units;
+        for (auto&& desc : getSortedProblemRunners())
+            desc.m_listWorkUnits(params, units);
+        return units;
+    }
+
+    /// Run every registered problem with parameters, log "Finished" with total stats at the end.
+    /// Returns false on first failure.
+    static bool runAll(const CLIParams& params)
+    {
+        PerformanceCounter topCounter(std::array<Perf, 2>{ Perf::ExecTime, Perf::PeakHeap });
+        for (auto&& cb : getSortedProblemRunners()) {
+            if (!cb.m_cb(params))
+                return false;
+        }
+        (*params.m_loggingStream) << "Finished";
+        topCounter.printTo(*params.m_loggingStream, true);
+        return true;
     }
 };
 
@@ -103,21 +188,71 @@ struct AbstractProblem final {
     using TestCase     = CommonTypes::TestCase<InputType, OutputType>;
     using TestCaseList = CommonTypes::TestCaseList<InputType, OutputType>;
 
+    using ExpectedOutputList = std::vector<StreamingCompare::ExpectedOutput>;
+
     struct TestCaseSource {
-        const TestCaseList* m_cases;
-        std::string_view    m_sourceName; // "compile", "source tree" etc.
+        const TestCaseList*       m_cases;
+        std::string_view          m_sourceName;         // "compile", "source tree" etc.
+        const ExpectedOutputList* m_expected = nullptr; // same size as m_cases; hashed entries replace m_output.
+
+        mutable std::vector<uint64_t> m_caseHashes = {}; // getCaseHash() results by case index, 0 = not calculated yet.
+
+        const StreamingCompare::ExpectedOutput* findHashed(size_t index) const
+        {
+            return m_expected && (*m_expected)[index].isHashed() ? &(*m_expected)[index] : nullptr;
+        }
     };
     using TestCaseSourceList = std::vector<TestCaseSource>;
 
-    using Transform = OutputType (*)(const InputType&);
+    using Transform         = OutputType (*)(const InputType&);
+    using ParallelTransform = OutputType (*)(const InputType&, const ParallelExecutor&);
+    using InPlaceTransform  = void (*)(const InputType&, OutputType&); // output is reused, it contains previous result.
     struct Solution {
-        Transform        m_transform = nullptr;
-        std::string_view m_implName;
-        std::string_view m_studentName;
+        Transform         m_transform = nullptr;
+        std::string_view  m_implName;
+        std::string_view  m_studentName;
+        uint64_t          m_pluginId          = 0; // unique for each loaded plugin instance, 0 for statically linked.
+        ParallelTransform m_parallelTransform = nullptr; // set instead of m_transform for parallel solutions.
+        bool              m_codeTestsVerified = false;   // code tests passed at compile time, see verifyConstexprTests().
+        InPlaceTransform  m_inPlaceTransform  = nullptr; // set instead of m_transform for solutions writing into given output.
+
+        OutputType operator()(const InputType& input, const ParallelExecutor& executor) const
+        {
+            if (m_inPlaceTransform) {
+                OutputType output{};
+                m_inPlaceTransform(input, output);
+                return output;
+            }
+            return m_parallelTransform ? m_parallelTransform(input, executor) : m_transform(input);
+        }
+
+        /// Timed call: in-place solution writes into given output, so its memory is reused between calls.
+        void operator()(const InputType& input, OutputType& output, const ParallelExecutor& executor) const
+        {
+            if (m_inPlaceTransform)
+                m_inPlaceTransform(input, output);
+            else
+                output = m_parallelTransform ? m_parallelTransform(input, executor) : m_transform(input);
+        }
     };
 
     using SolutionList = std::vector<Solution>;
 
+    /// Solutions in run order with interned student and impl names, so filters are matched once per distinct name.
+    /// Rebuilt only when solution list changes.
+    struct SolutionIndex {
+        struct Entry {
+            const Solution* m_solution     = nullptr;
+            uint32_t        m_studentIndex = 0;
+            uint32_t        m_implIndex    = 0;
+            uint64_t        m_idHash       = 0; // used for sharding.
+        };
+        std::vector<Entry>            m_entries;
+        std::vector<std::string_view> m_students;
+        std::vector<std::string_view> m_impls;
+        bool                          m_dirty = true;
+    };
+
     constexpr static std::string_view s_problemName = problemName.m_chars;
 
     static SolutionList& getSolutions()
@@ -126,9 +261,153 @@ struct AbstractProblem final {
         return impls;
     }
 
-    static void registerSolution(Transform t, std::string_view implName, std::string_view studentName)
+    static SolutionIndex& getSolutionIndex()
+    {
+        static SolutionIndex index;
+        return index;
+    }
+
+    static const SolutionIndex& getSolutionIndex(const CLIParams& params)
+    {
+        SolutionIndex& index = getSolutionIndex();
+        if (!index.m_dirty)
+            return index;
+
+        const Tracing::Span span("index solutions", "init");
+        auto&               solutions = getSolutions();
+        std::sort(solutions.begin(), solutions.end(), [&params](const Solution& l, const Solution& r) {
+            return params.makeOrderingTuple(l.m_studentName, l.m_implName)
+                   < params.makeOrderingTuple(r.m_studentName, r.m_implName);
+        });
+        std::map<std::string_view, uint32_t> students, impls;
+
+        auto intern = [](std::map<std::string_view, uint32_t>& ids, std::vector<std::string_view>& names, std::string_view name) {
+            auto [it, inserted] = ids.insert({ name, uint32_t(names.size()) });
+            if (inserted)
+                names.push_back(name);
+            return it->second;
+        };
+        index = {};
+        for (const Solution& solution : solutions) {
+            index.m_entries.push_back({ &solution,
+                                        intern(students, index.m_students, solution.m_studentName),
+                                        intern(impls, index.m_impls, solution.m_implName),
+                                        ResultCache::hashBytes(makeSolutionId(solution)) });
+        }
+        index.m_dirty = false;
+        return index;
+    }
+
+    static void registerSolution(Transform t, std::string_view implName, std::string_view studentName, bool codeTestsVerified = false)
+    {
+        getSolutions().push_back({ .m_transform = t, .m_implName = implName, .m_studentName = studentName, .m_codeTestsVerified = codeTestsVerified });
+        getSolutionIndex().m_dirty = true;
+    }
+
+    static void registerSolution(ParallelTransform t, std::string_view implName, std::string_view studentName, bool codeTestsVerified = false)
     {
-        getSolutions().push_back({ t, implName, studentName });
+        getSolutions().push_back({ .m_implName = implName, .m_studentName = studentName, .m_parallelTransform = t, .m_codeTestsVerified = codeTestsVerified });
+        getSolutionIndex().m_dirty = true;
+    }
+
+    static void registerSolution(InPlaceTransform t, std::string_view implName, std::string_view studentName, bool codeTestsVerified = false)
+    {
+        getSolutions().push_back({ .m_implName = implName, .m_studentName = studentName, .m_codeTestsVerified = codeTestsVerified, .m_inPlaceTransform = t });
+        getSolutionIndex().m_dirty = true;
+    }
+
+    /// Index of first failed case, -1 if all cases passed. Used in constant evaluation, see verifyConstexprTests().
+    template<auto solutionFunc, auto testsFunc>
+    static constexpr int findFailedConstexprCase()
+    {
+        const TestCaseList tests = testsFunc();
+        for (size_t i = 0; i < tests.size(); ++i) {
+            if (!(solutionFunc(tests[i].m_input) == tests[i].m_output))
+                return int(i);
+        }
+        return -1;
+    }
+
+    /// Failed case index is shown in compiler error as ConstexprCaseCheck<index>.
+    template<int failedCase>
+    struct ConstexprCaseCheck {
+        static constexpr bool s_passed = failedCase < 0;
+    };
+
+    /// Check code tests during compilation, if solution can be evaluated at compile time on all of them
+    /// (it is constexpr and has no UB on test inputs). Failed case is a compilation error.
+    /// Returns false when solution can not be evaluated, then code tests are checked at runtime as usual.
+    template<auto solutionFunc, auto testsFunc>
+    static constexpr bool verifyConstexprTests()
+    {
+        if constexpr (std::is_invocable_r_v<OutputType, decltype(solutionFunc), const InputType&>) {
+            if constexpr (requires { typename std::integral_constant<int, findFailedConstexprCase<solutionFunc, testsFunc>()>; }) {
+                static_assert(ConstexprCaseCheck<findFailedConstexprCase<solutionFunc, testsFunc>()>::s_passed,
+                              "Solution fails code test at compile time");
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Register solution from a shared library; returns false if plugin was built for different Input/Output.
+    static bool acceptPluginSolution(std::string_view          signature,
+                                     std::string_view          abiKey,
+                                     PluginApi::GenericFunction function,
+                                     std::string_view          implName,
+                                     std::string_view          studentName,
+                                     uint64_t                  pluginId)
+    {
+        static const std::string s_abiKey = PluginApi::makeAbiKey<InputType, OutputType>(getHeadersHash());
+        if (abiKey != s_abiKey)
+            return false;
+        if (signature == typeid(Transform).name())
+            getSolutions().push_back({ reinterpret_cast<Transform>(function), implName, studentName, pluginId });
+        else if (signature == typeid(ParallelTransform).name())
+            getSolutions().push_back({ nullptr, implName, studentName, pluginId, reinterpret_cast<ParallelTransform>(function) });
+        else if (signature == typeid(InPlaceTransform).name())
+            getSolutions().push_back({ nullptr, implName, studentName, pluginId, nullptr, false, reinterpret_cast<InPlaceTransform>(function) });
+        else
+            return false;
+        getSolutionIndex().m_dirty = true;
+        return true;
+    }
+
+    /// Must be called before plugin is unloaded, as solution names point to plugin memory.
+    static void removePluginSolutions(uint64_t pluginId)
+    {
+        std::erase_if(getSolutions(), [pluginId](const Solution& solution) { return solution.m_pluginId == pluginId; });
+        getSolutionIndex().m_dirty = true;
+    }
+
+    /// Same format as CMake solution id: problem_student_impl
+    static std::string makeSolutionId(const Solution& solution)
+    {
+        return std::string(s_problemName) + "_" + std::string(solution.m_studentName) + "_" + std::string(solution.m_implName);
+    }
+
+    /// Hash of serialized input and output, calculated once for each case and kept in the source.
+    static uint64_t getCaseHash(const TestCaseSource& tcaseSource, const TestCase& tcase)
+    {
+        const size_t index = &tcase - tcaseSource.m_cases->data();
+        tcaseSource.m_caseHashes.resize(tcaseSource.m_cases->size());
+        uint64_t& hash = tcaseSource.m_caseHashes[index];
+        if (hash)
+            return hash;
+
+        // data is hashed while it is written, so big cases are never serialized into memory.
+        ResultCache::HashStreamBuf buf;
+        std::ostream               os(&buf);
+        // position is added too, as writeTo() may be left empty for code-only tests.
+        os << s_problemName << "/" << tcaseSource.m_sourceName << "/" << index << "\n";
+        tcase.m_input.writeTo(os);
+        os << "\n";
+        if (const auto* expected = tcaseSource.findHashed(index))
+            os << expected->m_digest.m_hash << " " << expected->m_digest.m_tokens;
+        else
+            tcase.m_output.writeTo(os);
+        os.flush();
+        return hash = buf.getHash();
     }
 
     static TestCaseSourceList& getTestCaseSourceList()
@@ -143,9 +422,94 @@ struct AbstractProblem final {
         std::sort(list.begin(), list.end(), [](auto& l, auto& r) { return l.m_sourceName < r.m_sourceName; });
     }
 
-    static void registerTestSet(const TestCaseList* list, std::string_view source)
+    static void registerTestSet(const TestCaseList* list, std::string_view source, const ExpectedOutputList* expected = nullptr)
+    {
+        getTestCaseSourceList().push_back({ list, source, expected });
+    }
+
+    /// Hash of problem header and common type headers, computed by CMake; part of plugin ABI key.
+    static const char*& getHeadersHash()
     {
-        getTestCaseSourceList().push_back({ list, source });
+        static const char* s_hash = "";
+        return s_hash;
+    }
+
+    /// Per-case time limit for reference machine, from "Time limit:" line of Problem.txt; 0 if not declared.
+    static int64_t& getTimeLimitUS()
+    {
+        static int64_t s_limitUS = 0;
+        return s_limitUS;
+    }
+
+    /// Declared limit divided by speed of this machine relative to reference one; only the speed factor is cached, as limit may be changed.
+    static int64_t getScaledTimeLimitUS()
+    {
+        static const double s_factor = Calibration::getSpeedFactor();
+        return std::max<int64_t>(int64_t(getTimeLimitUS() / s_factor), 1);
+    }
+
+    /// Whether CheckOutput run compares solution time with the limit.
+    static bool isTimeLimitChecked(const CLIParams& params)
+    {
+        return params.m_timeLimits && params.m_task == CLIParams::Task::CheckOutput && getTimeLimitUS() > 0;
+    }
+
+    /// Logged on each run, so every request of server mode gets it in its own log.
+    static void logScaledTimeLimit(std::ostream& logger)
+    {
+        const Calibration::Scores& scores = Calibration::getScores();
+        logger << "Problem '" << s_problemName << "' time limit: " << getTimeLimitUS() << " us. on reference machine, "
+               << getScaledTimeLimitUS() << " us. here (speed factor " << std::setprecision(3) << Calibration::getSpeedFactor()
+               << "; integer " << scores.m_integerOpsPerNs << " ops/ns, memory latency " << scores.m_memoryLatencyNs
+               << " ns, bandwidth " << scores.m_memoryBandwidth / 1e9 << " GB/s" << (Calibration::isCached() ? ", cached" : "") << ")\n"
+               << std::setprecision(6);
+    }
+
+    /// Solutions passing student, impl and shard filters, in run order.
+    static std::vector<const Solution*> selectSolutions(const CLIParams& params)
+    {
+        const SolutionIndex& index = getSolutionIndex(params);
+        std::vector<char>    studentMatches(index.m_students.size());
+        std::vector<char>    implMatches(index.m_impls.size());
+        for (size_t i = 0; i < index.m_students.size(); ++i)
+            studentMatches[i] = !params.isFilteredStudent(index.m_students[i]);
+        for (size_t i = 0; i < index.m_impls.size(); ++i)
+            implMatches[i] = !params.isFilteredImpl(index.m_impls[i]);
+
+        std::vector<const Solution*> result;
+        for (const auto& entry : index.m_entries) {
+            if (studentMatches[entry.m_studentIndex] && implMatches[entry.m_implIndex] && !params.isFilteredShard(entry.m_idHash))
+                result.push_back(entry.m_solution);
+        }
+        return result;
+    }
+
+    static void listWorkUnits(const CLIParams& params, AbstractProblemData::WorkUnitList& units)
+    {
+        if (params.isFilteredProblem(s_problemName))
+            return;
+        sortTestCaseSourceList();
+        for (const Solution* solution : selectSolutions(params)) {
+            for (const TestCaseSource& tcaseSource : getTestCaseSourceList()) {
+                if (!params.isFilteredSource(tcaseSource.m_sourceName))
+                    units.push_back({ s_problemName, solution->m_studentName, solution->m_implName, tcaseSource.m_sourceName });
+            }
+        }
+    }
+
+    /// Keys of incremental check passes, one for each test source the run checks: a run with narrower source filter or
+    /// without time limits does not cover later full run. Pass with time limits also covers run without them.
+    /// Reloaded plugin gets new id, so changed solution will not be skipped.
+    static std::vector<std::string> makePassKeys(const CLIParams& params, const Solution& solution, bool timeLimitChecked)
+    {
+        const std::string solutionKey = makeSolutionId(solution) + "#" + std::to_string(solution.m_pluginId) + (timeLimitChecked ? "/time-limit/" : "/");
+
+        std::vector<std::string> result;
+        for (const TestCaseSource& tcaseSource : getTestCaseSourceList()) {
+            if (!params.isFilteredSource(tcaseSource.m_sourceName))
+                result.push_back(solutionKey + std::string(tcaseSource.m_sourceName));
+        }
+        return result;
     }
 
     /// Run test or benchmark with parameters.
@@ -155,23 +519,51 @@ struct AbstractProblem final {
         if (params.isFilteredProblem(s_problemName))
             return true;
 
-        auto& solutions = getSolutions();
-        std::sort(solutions.begin(), solutions.end(), [&params](const Solution& l, const Solution& r) {
-            return params.makeOrderingTuple(l.m_studentName, l.m_implName)
-                   < params.makeOrderingTuple(r.m_studentName, r.m_implName);
-        });
-        std::ostream& logger = *params.m_loggingStream;
+        const Tracing::Span    problemSpan(s_problemName, "problem");
+        std::ostream&          logger = *params.m_loggingStream;
+        const ParallelExecutor executor(params.m_threadCount);
 
-        for (const Solution& solution : solutions) {
-            if (params.isFilteredImpl(solution.m_implName) || params.isFilteredStudent(solution.m_studentName))
+        const std::vector<const Solution*> solutions = selectSolutions(params);
+        if (!solutions.empty() && isTimeLimitChecked(params))
+            logScaledTimeLimit(logger);
+
+        for (const Solution* solutionPtr : solutions) {
+            const Solution&     solution = *solutionPtr;
+            const Tracing::Span solutionSpan(makeSolutionId(solution), "solution");
+
+            // custom test data may differ between requests, so such runs are never skipped or recorded.
+            if (params.m_task == CLIParams::Task::CheckOutput && params.m_passedSolutions && !params.m_testInputStream && !params.m_testOutputStream) {
+                const std::vector<std::string> passKeys   = makePassKeys(params, solution, isTimeLimitChecked(params));
+                const std::vector<std::string> strictKeys = makePassKeys(params, solution, true);
+                bool                           unchanged  = true;
+                for (size_t i = 0; i < passKeys.size(); ++i)
+                    unchanged = unchanged && (params.m_passedSolutions->contains(passKeys[i]) || params.m_passedSolutions->contains(strictKeys[i]));
+                if (unchanged) {
+                    logger << "Skipping problem '" << s_problemName
+                           << "' student '" << solution.m_studentName
+                           << "' solution '" << solution.m_implName << "' - unchanged since last pass.\n";
+                    continue;
+                }
+                if (!runTests(params, solution, executor, true))
+                    return false;
+                params.m_passedSolutions->insert(passKeys.begin(), passKeys.end());
                 continue;
+            }
 
-            if (params.m_task == CLIParams::Task::CheckOutput && !runTests(params, solution, true))
+            if (params.m_task == CLIParams::Task::CheckOutput && !runTests(params, solution, executor, true))
                 return false;
-            if (params.m_task == CLIParams::Task::PrintOutput && !runTests(params, solution, false))
+            if (params.m_task == CLIParams::Task::PrintOutput && !runTests(params, solution, executor, false))
                 return false;
 
-            if (params.m_task == CLIParams::Task::Benchmark && !runBenchmark(params, solution))
+            if (params.m_task == CLIParams::Task::Benchmark && !runBenchmark(params, solution, executor))
+                return false;
+            if (params.m_task == CLIParams::Task::Scaling && !runScaling(params, solution))
+                return false;
+            if (params.m_task == CLIParams::Task::Contention && !runContention(params, solution))
+                return false;
+            if (params.m_task == CLIParams::Task::Stress && !runStress(params, solution, executor))
+                return false;
+            if (params.m_task == CLIParams::Task::History && !runHistory(params, solution))
                 return false;
         }
         logger << "Problem '" << s_problemName;
@@ -179,38 +571,73 @@ struct AbstractProblem final {
             logger << "' - all tests passed!\n";
         if (params.m_task == CLIParams::Task::PrintOutput)
             logger << "' - finished!\n";
-        if (params.m_task == CLIParams::Task::Benchmark)
+        if (params.m_task == CLIParams::Task::Benchmark || params.m_task == CLIParams::Task::Scaling || params.m_task == CLIParams::Task::Contention)
             logger << "' - end of benchmark\n";
+        if (params.m_task == CLIParams::Task::Stress)
+            logger << "' - end of stress search\n";
+        if (params.m_task == CLIParams::Task::History)
+            logger << "' - end of history\n";
         logger << std::flush;
         return true;
     }
 
     static void registerCustomSource(const CLIParams& params)
     {
-        static TestCaseList s_customSource(1);
+        static TestCaseList s_customSource;
         static bool         s_loadDone = false;
         if (s_loadDone)
             return;
 
+        // parsed in usual memory, only final values are placed into test arena.
         bool useCustomSource = false;
+        s_customSource       = TestArena::place(TestCaseList(1));
         if (params.m_testInputStream) {
             useCustomSource = true;
-            s_customSource[0].m_input.readFrom(*params.m_testInputStream);
+            InputType input{};
+            input.readFrom(*params.m_testInputStream);
+            s_customSource[0].m_input = TestArena::place(std::move(input));
         }
         if (params.m_testOutputStream) {
             useCustomSource = true;
-            s_customSource[0].m_output.readFrom(*params.m_testOutputStream);
+            OutputType output{};
+            output.readFrom(*params.m_testOutputStream);
+            s_customSource[0].m_output = TestArena::place(std::move(output));
         }
         if (useCustomSource) {
             auto& customList = getTestCaseSourceList();
             customList.resize(1);
-            customList[0].m_sourceName = params.useStdin() ? "cli-stdin" : "cli-file";
-            customList[0].m_cases      = &s_customSource;
+            customList[0] = TestCaseSource{ &s_customSource, params.useStdin() ? "cli-stdin" : "cli-file", nullptr };
         }
         s_loadDone = true;
     }
 
-    static bool runTests(const CLIParams& params, const Solution& solution, bool needCheck)
+    /// Find first differing token by streaming expected and calculated outputs. Digest is made from canonical writeTo() form of
+    /// expected value, so it is written to temporary file the same way, otherwise formatting of original file would be reported.
+    static void logMismatch(std::ostream& logger, const StreamingCompare::ExpectedOutput& expected, const OutputType& calculatedOutput)
+    {
+        const std::filesystem::path canonicalPath = std::filesystem::temp_directory_path()
+                                                    / ("contest_checker_expected_" + std::to_string(std::random_device{}()) + ".txt");
+        {
+            OutputType expectedValue{};
+            expectedValue.readFrom(*TestFiles::open(expected.m_path));
+            std::ofstream canonicalFile(canonicalPath);
+            expectedValue.writeTo(canonicalFile);
+        }
+        const auto mismatch = StreamingCompare::findFirstMismatch(canonicalPath.string(), [&calculatedOutput](std::ostream& os) { calculatedOutput.writeTo(os); });
+        std::error_code ec;
+        std::filesystem::remove(canonicalPath, ec);
+
+        logger << "file " << expected.m_path << " (" << expected.m_digest.m_tokens << " tokens)";
+        if (mismatch) {
+            auto quoted = [](const std::string& token) { return token.empty() ? std::string("<end of output>") : "'" + token + "'"; };
+            logger << ", first difference at token " << mismatch->m_tokenIndex << " (line " << mismatch->m_line << " as written by writeTo()): expected "
+                   << quoted(mismatch->m_expected) << ", calculated " << quoted(mismatch->m_calculated);
+        } else {
+            logger << ", outputs are the same when compared by tokens, but digest differs";
+        }
+    }
+
+    static bool runTests(const CLIParams& params, const Solution& solution, const ParallelExecutor& executor, bool needCheck)
     {
         std::ostream& logger = *params.m_loggingStream;
 
@@ -221,49 +648,126 @@ struct AbstractProblem final {
 
         registerCustomSource(params);
 
-        PerformanceCounter topCounter(std::array<Perf, 2>{ Perf::ExecTime, Perf::CpuClock });
+        ResultCache* cache        = nullptr;
+        uint64_t     solutionHash = 0;
+        if (needCheck && !params.m_noCache) {
+            cache        = &ResultCache::get(params.m_cacheFile.empty() ? ResultCache::getDefaultPath() : params.m_cacheFile);
+            solutionHash = ResultCache::hashSolution(solution.m_pluginId, makeSolutionId(solution));
+        }
+
+        // time limit is a verdict of CheckOutput only; other tasks use tests just to make sure solution is correct.
+        // calibration may take a while on the first run, so it is done before time measurement starts.
+        const int64_t timeLimitUS = needCheck && isTimeLimitChecked(params) ? getScaledTimeLimitUS() : 0;
+
+        PerformanceCounter topCounter(std::array<Perf, 4>{ Perf::ExecTime, Perf::CpuClock, Perf::MinorFaults, Perf::MajorFaults });
 
         if (params.m_enableAllocTrace)
             topCounter.enablePerf(std::array<Perf, 3>{ Perf::NewCalls, Perf::DeleteCalls, Perf::TimeSpentAlloc });
-        size_t count = 0;
+        size_t count         = 0;
+        size_t cachedCount   = 0;
+        size_t verifiedCount = 0;
+        size_t tleCount      = 0;
         sortTestCaseSourceList();
 
+        auto checkCaseTime = [&](const std::string& tcaseIndexStr, int64_t execTimeUS, bool cached) {
+            if (!timeLimitUS || execTimeUS <= timeLimitUS)
+                return;
+            tleCount++;
+            logger << "Case " << tcaseIndexStr << " time limit exceeded" << (cached ? " (cached)" : "") << ", exec time: " << execTimeUS
+                   << " us., limit: " << timeLimitUS << " us.\n";
+        };
+
+        // same output for all cases, so in-place solution is timed as in benchmark, and must overwrite previous result.
+        OutputType reusedOutput{};
         for (const TestCaseSource& tcaseSource : getTestCaseSourceList()) {
+            if (params.isFilteredSource(tcaseSource.m_sourceName))
+                continue;
+            if (needCheck && solution.m_codeTestsVerified && tcaseSource.m_sourceName == "code") {
+                count += tcaseSource.m_cases->size();
+                verifiedCount += tcaseSource.m_cases->size();
+                continue;
+            }
             for (int tcaseIndex = -1; const TestCase& tcase : *tcaseSource.m_cases) {
                 tcaseIndex++;
                 count++;
                 const std::string tcaseIndexStr = "[" + std::string(tcaseSource.m_sourceName) + "/" + std::to_string(tcaseIndex) + "]";
 
-                PerformanceCounter caseCounter(Perf::ExecTime);
+                // failed results are never skipped, as we need to print failure details.
+                const uint64_t caseHash = cache ? getCaseHash(tcaseSource, tcase) : 0;
+                if (const ResultCache::Entry* cached = cache ? cache->find(solutionHash, caseHash) : nullptr; cached && cached->m_passed) {
+                    cachedCount++;
+                    if (params.m_printAllCases)
+                        logger << "Case " << tcaseIndexStr << " cached, exec time: " << cached->m_execTimeUS << " us.\n";
+                    checkCaseTime(tcaseIndexStr, cached->m_execTimeUS, true);
+                    continue;
+                }
+
+                Tracing::Span caseSpan(tcaseIndexStr, "case");
+                caseSpan.setArg("index", tcaseIndex);
+
+#ifdef CONTEST_CHECKER_SOLUTION_PHASES
+                SolutionPhases::reset();
+#endif
+                // faults are read before time starts, so getrusage() calls are not measured.
+                PerformanceCounter caseCounter = params.m_printAllCases
+                                                     ? PerformanceCounter(std::array<Perf, 3>{ Perf::MinorFaults, Perf::MajorFaults, Perf::ExecTime })
+                                                     : PerformanceCounter(Perf::ExecTime);
                 if (params.m_enableAllocTrace)
                     caseCounter.enablePerf(std::array<Perf, 2>{ Perf::NewCalls, Perf::DeleteCalls });
 
                 {
-                    const auto calculatedOutput = solution.m_transform(tcase.m_input);
+                    const StreamingCompare::ExpectedOutput* hashedOutput = tcaseSource.findHashed(tcaseIndex);
+                    std::optional<Tracing::Span>            phaseSpan(std::in_place, "solve", "phase");
+                    solution(tcase.m_input, reusedOutput, executor);
+                    const OutputType&                       calculatedOutput = reusedOutput;
+                    const int64_t                           solveUS          = caseCounter.getElapsedUS();
                     if (!needCheck) {
-                        tcase.m_output.writeTo(*params.m_printStream);
+                        phaseSpan.emplace("print", "phase");
+                        if (hashedOutput)
+                            *params.m_printStream << TestFiles::open(hashedOutput->m_path)->rdbuf();
+                        else
+                            tcase.m_output.writeTo(*params.m_printStream);
                         *params.m_printStream << "\n"
                                               << std::flush;
                         continue;
                     }
-                    if (calculatedOutput != tcase.m_output) {
-                        const std::string tcaseIndexPad(tcaseIndexStr.size(), ' ');
+                    phaseSpan.emplace("compare", "phase");
+                    // huge expected output is not kept in memory, calculated one is compared with its digest while being written.
+                    const bool isEqual = hashedOutput ? StreamingCompare::digestOf(calculatedOutput) == hashedOutput->m_digest
+                                                      : calculatedOutput == tcase.m_output;
+                    phaseSpan.reset();
+                    if (!isEqual) {
+                        const Tracing::Span logSpan("log failure", "phase");
+                        const std::string   tcaseIndexPad(tcaseIndexStr.size(), ' ');
                         logger << "For problem input " << tcaseIndexStr << ": ";
                         tcase.m_input.log(logger);
                         logger << "\n";
                         logger << "expected output" << tcaseIndexPad << " is: ";
-                        tcase.m_output.log(logger);
+                        if (hashedOutput)
+                            logMismatch(logger, *hashedOutput, calculatedOutput);
+                        else
+                            tcase.m_output.log(logger);
                         logger << "\n";
                         logger << " but calculated" << tcaseIndexPad << " is: ";
                         calculatedOutput.log(logger);
                         logger << "\n"
                                << std::flush;
+                        if (cache) {
+                            cache->store(solutionHash, caseHash, { false, solveUS });
+                            cache->flush();
+                        }
                         return false;
                     }
+                    if (cache)
+                        cache->store(solutionHash, caseHash, { true, solveUS });
+                    checkCaseTime(tcaseIndexStr, solveUS, false);
                 }
                 if (params.m_printAllCases) {
                     logger << "Case " << tcaseIndexStr;
                     caseCounter.printTo(logger, true);
+#ifdef CONTEST_CHECKER_SOLUTION_PHASES
+                    SolutionPhases::printTo(logger);
+#endif
                 }
             }
         }
@@ -271,12 +775,23 @@ struct AbstractProblem final {
         if (!needCheck)
             return true;
 
+        if (cache)
+            cache->flush();
+
         logger << "Solutions are correct, total cases: " << count;
+        if (cachedCount)
+            logger << " (" << cachedCount << " cached)";
+        if (verifiedCount)
+            logger << " (" << verifiedCount << " verified at compile time)";
         topCounter.printTo(logger, true);
+        if (tleCount) {
+            logger << "Time limit exceeded on " << tleCount << " of " << count << " cases, limit: " << timeLimitUS << " us.\n";
+            return false;
+        }
         return true;
     }
 
-    static bool runBenchmark(const CLIParams& params, const Solution& solution)
+    static bool runBenchmark(const CLIParams& params, const Solution& solution, const ParallelExecutor& executor)
     {
         std::ostream& logger = *params.m_loggingStream;
 
@@ -287,23 +802,502 @@ struct AbstractProblem final {
                << std::flush;
         registerCustomSource(params);
 
+        const auto [iterationElements, iterationBytes] = getIterationSize(params);
+        const double memoryBandwidth                     = iterationBytes ? Calibration::getMemoryBandwidth() : 0.0;
+
+#ifdef CONTEST_CHECKER_SOLUTION_PHASES
+        // phase names may point to unloaded plugin otherwise.
+        SolutionPhases::reset();
+#endif
+        std::optional<SamplingProfiler> profiler;
+        if (params.m_profile)
+            profiler.emplace();
+
+        // steady state of in-place solution: output memory is allocated on the first call and then reused.
+        OutputType              reusedOutput{};
+        const CustomAlloc::Info startNewInfo    = CustomAlloc::getNewInfo();
+        const CustomAlloc::Info startDeleteInfo = CustomAlloc::getDeleteInfo();
+
+        // filters are matched once, so loop overhead is not a part of measured time.
+        std::vector<const TestCaseList*> caseLists;
+        for (const TestCaseSource& tcaseSource : getTestCaseSourceList()) {
+            if (!params.isFilteredSource(tcaseSource.m_sourceName))
+                caseLists.push_back(tcaseSource.m_cases);
+        }
+
         PerformanceCounter topCounter(Perf::ExecTime);
         if (params.m_enableAllocTrace)
             topCounter.enablePerf(Perf::TimeSpentAlloc);
-        int iterationCount = 0;
+        constexpr int64_t            traceBatchUS    = 10'000; // 10 ms.
+        int                          iterationCount  = 0;
+        int64_t                      doneIterations  = 0;
+        int                          batchIterations = 0;
+        int64_t                      batchStartUS    = 0;
+        std::optional<Tracing::Span> batchSpan(std::in_place, "batch", "benchmark");
         for (; iterationCount < 10'000'000; ++iterationCount) {
-            for (const TestCaseSource& tcaseSource : getTestCaseSourceList()) {
-                for (const TestCase& tcase : *tcaseSource.m_cases) {
-                    solution.m_transform(tcase.m_input);
-                }
+            for (const TestCaseList* cases : caseLists) {
+                for (const TestCase& tcase : *cases)
+                    solution(tcase.m_input, reusedOutput, executor);
             }
+            batchIterations++;
+            doneIterations++;
 
-            if (topCounter.isTimedOut(params.m_benchmarkTimeLimitMS * 1000))
+            // clock is read once per iteration, both checks use the same time.
+            const int64_t iterationEndUS = topCounter.getElapsedUS();
+            if (iterationEndUS > params.m_benchmarkTimeLimitMS * 1000)
                 break;
+
+            // one span per iteration would overflow trace buffer, so iterations are grouped.
+            if (iterationEndUS - batchStartUS >= traceBatchUS) {
+                batchSpan->setArg("iterations", batchIterations);
+                batchSpan.emplace("batch", "benchmark");
+                batchIterations = 0;
+                batchStartUS    = iterationEndUS;
+            }
         }
+        batchSpan->setArg("iterations", batchIterations);
+        batchSpan.reset();
+
+        if (profiler)
+            profiler->stop();
 
+        const int64_t elapsedUS = topCounter.getElapsedUS();
         logger << "Benchmark ended, iterations: " << iterationCount;
         topCounter.printTo(logger, true);
+        if (iterationBytes && elapsedUS > 0)
+            printThroughput(logger, "Throughput", doneIterations * iterationElements, doneIterations * iterationBytes, elapsedUS, memoryBandwidth);
+        if (doneIterations > 0 && elapsedUS > 0)
+            printAllocationShare(logger, CustomAlloc::getNewInfo() - startNewInfo, CustomAlloc::getDeleteInfo() - startDeleteInfo, doneIterations, elapsedUS);
+        if (profiler) {
+            profiler->printHotFunctions(logger, 15);
+            if (params.m_profileStream)
+                profiler->writeFoldedStacks(*params.m_profileStream, makeSolutionId(solution));
+        }
+        // profiler overhead would look like a regression.
+        const std::string historyPath = getHistoryPath(params);
+        if (!historyPath.empty() && !profiler && doneIterations > 0) {
+            BenchmarkHistory::Record record;
+            record.m_timestamp      = int64_t(std::time(nullptr));
+            record.m_problem        = s_problemName;
+            record.m_student        = solution.m_studentName;
+            record.m_impl           = solution.m_implName;
+            record.m_sources        = params.m_sourceFilter.empty() ? "*" : params.m_sourceFilter.m_value;
+            record.m_revision       = BenchmarkHistory::getRevision();
+            record.m_host           = Calibration::getHostFingerprint();
+            record.m_nsPerIteration = elapsedUS * 1000.0 / doneIterations;
+            BenchmarkHistory::append(historyPath, record);
+        }
+        return true;
+    }
+
+    static std::string getHistoryPath(const CLIParams& params)
+    {
+        if (params.m_historyFile == CLIParams::g_null)
+            return {};
+        return params.m_historyFile.empty() ? BenchmarkHistory::getDefaultPath() : params.m_historyFile;
+    }
+
+    /// Change points of benchmark results recorded on this host, separately for each set of test sources.
+    static bool runHistory(const CLIParams& params, const Solution& solution)
+    {
+        std::ostream&     logger = *params.m_loggingStream;
+        const std::string host   = Calibration::getHostFingerprint();
+
+        std::map<std::string, std::vector<BenchmarkHistory::Record>> seriesBySources;
+        size_t                                                       otherHostRuns = 0;
+        for (BenchmarkHistory::Record& record : BenchmarkHistory::load(getHistoryPath(params))) {
+            if (record.m_problem != s_problemName || record.m_student != solution.m_studentName || record.m_impl != solution.m_implName)
+                continue;
+            if (record.m_host != host) {
+                otherHostRuns++;
+                continue;
+            }
+            seriesBySources[record.m_sources].push_back(std::move(record));
+        }
+
+        logger << "History of problem '" << s_problemName
+               << "' student '" << solution.m_studentName
+               << "' solution '" << solution.m_implName << "'";
+        if (otherHostRuns)
+            logger << " (" << otherHostRuns << " runs on other hosts are skipped)";
+        logger << ":\n";
+        if (seriesBySources.empty())
+            logger << "  no benchmark results on this host.\n";
+
+        logger << std::fixed << std::setprecision(1);
+        for (const auto& [sources, records] : seriesBySources) {
+            std::vector<double> values;
+            for (const BenchmarkHistory::Record& record : records)
+                values.push_back(record.m_nsPerIteration);
+
+            logger << "  sources '" << sources << "': " << records.size() << " runs, revisions " << records.front().m_revision
+                   << " .. " << records.back().m_revision << ", last " << values.back() << " ns/iteration\n";
+            const auto changes = BenchmarkHistory::detectChangePoints(values);
+            if (changes.empty())
+                logger << "    no significant changes\n";
+            for (const BenchmarkHistory::ChangePoint& change : changes) {
+                const BenchmarkHistory::Record& before  = records[change.m_index - 1];
+                const BenchmarkHistory::Record& after   = records[change.m_index];
+                const double                    percent = 100.0 * (change.m_meanAfter - change.m_meanBefore) / change.m_meanBefore;
+                logger << "    run " << change.m_index << ": " << change.m_meanBefore << " -> " << change.m_meanAfter << " ns/iteration ("
+                       << std::showpos << percent << std::noshowpos << "%, " << (percent > 0 ? "slower" : "faster") << ") at revision " << after.m_revision;
+                if (before.m_revision != after.m_revision)
+                    logger << ", previous run at " << before.m_revision << "\n";
+                else
+                    logger << ", same as previous run - not caused by code change\n";
+            }
+        }
+        logger << std::defaultfloat << std::setprecision(6);
+        return true;
+    }
+
+    /// Elements and bytes processed by one pass over all test cases; output is counted as memory traffic too.
+    /// Zeros if Input or Output have no size traits.
+    static std::pair<size_t, size_t> getIterationSize(const CLIParams& params)
+    {
+        size_t elements = 0;
+        size_t bytes    = 0;
+        if constexpr (CommonTypes::Details::HasByteCount<InputType> && CommonTypes::Details::HasByteCount<OutputType>) {
+            for (const TestCaseSource& tcaseSource : getTestCaseSourceList()) {
+                if (params.isFilteredSource(tcaseSource.m_sourceName))
+                    continue;
+                for (const TestCase& tcase : *tcaseSource.m_cases) {
+                    elements += tcase.m_input.elementCount();
+                    bytes += tcase.m_input.byteCount() + tcase.m_output.byteCount();
+                }
+            }
+        }
+        return { elements, bytes };
+    }
+
+    static void printThroughput(std::ostream& logger, std::string_view label, double elements, double bytes, int64_t elapsedUS, double memoryBandwidth)
+    {
+        auto withPrefix = [](double value) {
+            const char* prefixes[] = { "", " K", " M", " G", " T" };
+            size_t      index      = 0;
+            while (value >= 1000.0 && index + 1 < std::size(prefixes)) {
+                value /= 1000.0;
+                index++;
+            }
+            std::ostringstream os;
+            os << std::fixed << std::setprecision(2) << value << prefixes[index];
+            return os.str();
+        };
+        const double seconds        = elapsedUS / 1e6;
+        const double bytesPerSecond = bytes / seconds;
+        logger << label << ": " << withPrefix(elements / seconds) << " items/s, "
+               << withPrefix(bytesPerSecond) << "B/s, "
+               << std::fixed << std::setprecision(3) << (elapsedUS * 1000.0 / std::max(elements, 1.0)) << " ns/item";
+        if (memoryBandwidth > 0)
+            logger << ", " << std::setprecision(1) << (100.0 * bytesPerSecond / memoryBandwidth) << "% of memory bandwidth ("
+                   << withPrefix(memoryBandwidth) << "B/s)";
+        logger << std::defaultfloat << "\n";
+    }
+
+    /// Part of benchmark time spent in new() and delete(), mostly on returned outputs.
+    static void printAllocationShare(std::ostream& logger, const CustomAlloc::Info& newInfo, const CustomAlloc::Info& deleteInfo, int64_t iterations, int64_t elapsedUS)
+    {
+        if (!CustomAlloc::isHookEnabled()) {
+            logger << "Allocation: no data, new() and delete() are counted only with ENABLE_NEW_DELETE_HOOK=ON\n";
+            return;
+        }
+        if (!newInfo.m_calls) {
+            logger << "Allocation: no new() calls during benchmark\n";
+            return;
+        }
+        const double allocUS = (newInfo.m_timeSpentNanosec + deleteInfo.m_timeSpentNanosec) / 1000.0;
+        logger << "Allocation: " << std::fixed << std::setprecision(1) << (100.0 * allocUS / elapsedUS) << "% of time in new+delete, "
+               << double(newInfo.m_calls) / iterations << " new() calls and " << double(newInfo.m_totalBytes) / iterations / 1024
+               << " kB per iteration; 'void solution(const Input&, Output&)' signature avoids allocation of outputs\n"
+               << std::defaultfloat << std::setprecision(6);
+    }
+
+    /// Benchmark parallel solution with 1, 2, 4 ... N threads, where N is '--threads' value.
+    /// Serial fraction is Karp-Flatt metric: e = (1/S - 1/p) / (1 - 1/p), for Amdahl law it is constant, growing value means parallel overhead.
+    static bool runScaling(const CLIParams& params, const Solution& solution)
+    {
+        std::ostream& logger = *params.m_loggingStream;
+
+        if (!solution.m_parallelTransform) {
+            logger << "Skipping problem '" << s_problemName
+                   << "' student '" << solution.m_studentName
+                   << "' solution '" << solution.m_implName << "' - solution is not parallel.\n";
+            return true;
+        }
+        registerCustomSource(params);
+
+        const int        maxThreads = params.m_threadCount > 0 ? params.m_threadCount : ParallelExecutor::getDefaultThreadCount();
+        std::vector<int> threadCounts;
+        for (int threads = 1; threads < maxThreads; threads *= 2)
+            threadCounts.push_back(threads);
+        threadCounts.push_back(maxThreads);
+        const int64_t stepLimitUS = params.m_benchmarkTimeLimitMS * 1000 / int64_t(threadCounts.size());
+
+        logger << "Starting problem '" << s_problemName
+               << "' student '" << solution.m_studentName
+               << "' solution '" << solution.m_implName
+               << "' scaling benchmark (" << params.m_benchmarkTimeLimitMS << " ms limit, up to " << maxThreads << " threads)...\n"
+               << std::flush;
+
+        OutputType reusedOutput{};
+        auto       runIteration = [&params, &solution, &reusedOutput](const ParallelExecutor& executor) {
+            for (const TestCaseSource& tcaseSource : getTestCaseSourceList()) {
+                if (params.isFilteredSource(tcaseSource.m_sourceName))
+                    continue;
+                for (const TestCase& tcase : *tcaseSource.m_cases)
+                    solution(tcase.m_input, reusedOutput, executor);
+            }
+        };
+
+        logger << "threads   time/iter, us.   speedup   efficiency   serial fraction\n";
+        double baseTimeUS     = 0;
+        double serialFraction = 0;
+        for (const int threads : threadCounts) {
+            const ParallelExecutor executor(threads);
+            runIteration(executor); // warm up caches and pool threads.
+
+            const Tracing::Span span("threads " + std::to_string(threads), "scaling");
+            PerformanceCounter  counter(Perf::ExecTime);
+            int64_t             iterations = 0;
+            do {
+                runIteration(executor);
+                iterations++;
+            } while (!counter.isTimedOut(stepLimitUS));
+
+            const double timeUS = double(counter.getElapsedUS()) / iterations;
+            if (threads == 1)
+                baseTimeUS = timeUS;
+            const double speedup    = timeUS > 0 ? baseTimeUS / timeUS : 1.0;
+            const double efficiency = speedup / threads;
+
+            logger << std::fixed << std::setprecision(2)
+                   << std::setw(7) << threads
+                   << std::setw(17) << timeUS
+                   << std::setw(10) << speedup
+                   << std::setw(12) << efficiency * 100 << "%";
+            if (threads > 1) {
+                serialFraction = (1.0 / speedup - 1.0 / threads) / (1.0 - 1.0 / threads);
+                logger << std::setw(18) << serialFraction;
+            } else {
+                logger << std::setw(18) << "-";
+            }
+            logger << std::defaultfloat << "\n";
+        }
+        if (maxThreads > 1) {
+            logger << "Estimated serial fraction: " << serialFraction;
+            // value above 1 means more threads make solution slower, so there is no meaningful limit.
+            if (serialFraction > 0 && serialFraction < 1)
+                logger << ", Amdahl speedup limit: " << 1.0 / serialFraction;
+            logger << "\n";
+        }
+        logger << std::flush;
         return true;
     }
+
+    /// Run K copies of solution at once, each on its own thread over its own copy of test inputs, and compare with a single copy.
+    /// Shows how solution behaves when memory bandwidth and last level cache are shared, as in production.
+    /// Time limit is split between single copy and concurrent runs.
+    static bool runContention(const CLIParams& params, const Solution& solution)
+    {
+        std::ostream& logger = *params.m_loggingStream;
+        registerCustomSource(params);
+
+        const int copyCount = params.m_copyCount > 0 ? params.m_copyCount : ParallelExecutor::getDefaultThreadCount();
+        logger << "Starting problem '" << s_problemName
+               << "' student '" << solution.m_studentName
+               << "' solution '" << solution.m_implName
+               << "' contention benchmark (" << params.m_benchmarkTimeLimitMS << " ms limit, " << copyCount << " copies)...\n"
+               << std::flush;
+
+        std::vector<const InputType*> inputs;
+        for (const TestCaseSource& tcaseSource : getTestCaseSourceList()) {
+            if (params.isFilteredSource(tcaseSource.m_sourceName))
+                continue;
+            for (const TestCase& tcase : *tcaseSource.m_cases)
+                inputs.push_back(&tcase.m_input);
+        }
+        const auto [iterationElements, iterationBytes] = getIterationSize(params);
+        const double  memoryBandwidth                  = iterationBytes ? Calibration::getMemoryBandwidth() : 0.0;
+        const int64_t stepLimitNs                      = params.m_benchmarkTimeLimitMS * 1'000'000 / 2;
+
+        // parallel solutions get one thread per copy; executor without threads runs tasks inline, so it can be shared.
+        const ParallelExecutor sequential(1);
+
+        struct CopyResult {
+            int64_t m_iterations = 0;
+            int64_t m_elapsedNs  = 0;
+            double  iterationsPerSecond() const { return m_iterations * 1e9 / std::max<int64_t>(m_elapsedNs, 1); }
+        };
+        auto runCopy = [&inputs, &solution, &sequential](std::latch* start, int64_t limitNs) {
+            // copy is made by the thread that uses it, so memory is local to its NUMA node.
+            std::vector<InputType> copy;
+            copy.reserve(inputs.size());
+            for (const InputType* input : inputs)
+                copy.push_back(*input);
+            if (start)
+                start->arrive_and_wait();
+
+            OutputType    output{};
+            CopyResult    result;
+            const int64_t startNs = PerformanceCounterDetails::getCurrentNanoseconds();
+            do {
+                for (const InputType& input : copy)
+                    solution(input, output, sequential);
+                result.m_iterations++;
+                result.m_elapsedNs = PerformanceCounterDetails::getCurrentNanoseconds() - startNs;
+            } while (result.m_elapsedNs < limitNs);
+            return result;
+        };
+
+        const CopyResult single = runCopy(nullptr, stepLimitNs);
+
+        std::vector<CopyResult> results(copyCount);
+        {
+            const Tracing::Span      span("contention", "benchmark");
+            std::latch               start(copyCount);
+            std::vector<std::thread> threads;
+            for (int i = 0; i < copyCount; ++i)
+                threads.emplace_back([&results, &runCopy, &start, stepLimitNs, i] { results[i] = runCopy(&start, stepLimitNs); });
+            for (std::thread& thread : threads)
+                thread.join();
+        }
+
+        double aggregate = 0, slowest = std::numeric_limits<double>::max(), fastest = 0;
+        for (const CopyResult& result : results) {
+            aggregate += result.iterationsPerSecond();
+            slowest = std::min(slowest, result.iterationsPerSecond());
+            fastest = std::max(fastest, result.iterationsPerSecond());
+        }
+        const double singleSpeed = single.iterationsPerSecond();
+        const double average     = aggregate / copyCount;
+
+        logger << std::fixed << std::setprecision(2)
+               << "Single copy: " << singleSpeed << " iterations/s\n"
+               << copyCount << " copies: " << aggregate << " iterations/s total (x" << aggregate / singleSpeed << " of single copy, ideal x" << copyCount << ")"
+               << ", per copy min/avg/max: " << slowest << "/" << average << "/" << fastest << " iterations/s\n"
+               << "Per-copy slowdown: " << singleSpeed / average << "x average, " << singleSpeed / slowest << "x worst\n"
+               << std::defaultfloat;
+        if (iterationBytes) {
+            printThroughput(logger, "Single copy throughput", double(single.m_iterations * iterationElements), double(single.m_iterations * iterationBytes), single.m_elapsedNs / 1000, memoryBandwidth);
+            int64_t totalIterations = 0, longestNs = 0;
+            for (const CopyResult& result : results) {
+                totalIterations += result.m_iterations;
+                longestNs = std::max(longestNs, result.m_elapsedNs);
+            }
+            printThroughput(logger, "All copies throughput", double(totalIterations * iterationElements), double(totalIterations * iterationBytes), longestNs / 1000, memoryBandwidth);
+        }
+        logger << std::flush;
+        return true;
+    }
+
+    /// Average time of one solution call: minimum over several rounds, each round is long enough to measure tiny inputs.
+    static double measureSolutionNs(const Solution& solution, const ParallelExecutor& executor, const InputType& input)
+    {
+        constexpr int     rounds  = 3;
+        constexpr int64_t roundNs = 200'000;
+
+        OutputType output{};
+        double     best = std::numeric_limits<double>::max();
+        for (int round = 0; round < rounds; ++round) {
+            const int64_t startNs   = PerformanceCounterDetails::getCurrentNanoseconds();
+            int64_t       calls     = 0;
+            int64_t       elapsedNs = 0;
+            do {
+                solution(input, output, executor);
+                calls++;
+                elapsedNs = PerformanceCounterDetails::getCurrentNanoseconds() - startNs;
+            } while (elapsedNs < roundNs);
+            best = std::min(best, double(elapsedNs) / calls);
+        }
+        return best;
+    }
+
+    /// Search for inputs on which solution is slowest. Every test case is a seed for hill climbing: each step applies
+    /// a few random mutations to the slowest input found so far and keeps the result if solution became slower.
+    /// Mutations keep input size, so found inputs are worst cases of the same size as their seeds.
+    /// Inputs at least 1.2 times slower than seed are saved as input_N.txt/output_N.txt to '--stress-dir'.
+    static bool runStress(const CLIParams& params, const Solution& solution, const ParallelExecutor& executor)
+    {
+        std::ostream& logger = *params.m_loggingStream;
+        if constexpr (!CommonTypes::Details::Mutable<InputType>) {
+            logger << "Skipping problem '" << s_problemName << "' - input type has no mutate() method, it can not be stress tested.\n";
+            return true;
+        } else {
+            constexpr double minSlowdown = 1.2; // smaller values are usually measurement noise.
+
+            // outputs for found inputs are calculated by this solution, so it must be correct.
+            if (!runTests(params, solution, executor, true))
+                return false;
+
+            logger << "Starting problem '" << s_problemName
+                   << "' student '" << solution.m_studentName
+                   << "' solution '" << solution.m_implName
+                   << "' stress search (" << params.m_benchmarkTimeLimitMS << " ms limit, seed " << params.m_stressSeed << ")...\n"
+                   << std::flush;
+
+            std::vector<std::pair<std::string, const InputType*>> seeds;
+            for (const TestCaseSource& tcaseSource : getTestCaseSourceList()) {
+                if (params.isFilteredSource(tcaseSource.m_sourceName))
+                    continue;
+                for (size_t i = 0; i < tcaseSource.m_cases->size(); ++i)
+                    seeds.push_back({ "[" + std::string(tcaseSource.m_sourceName) + "/" + std::to_string(i) + "]", &(*tcaseSource.m_cases)[i].m_input });
+            }
+            if (seeds.empty())
+                return true;
+
+            std::mt19937_64        rng(params.m_stressSeed);
+            const int64_t          seedLimitNs = params.m_benchmarkTimeLimitMS * 1'000'000 / int64_t(seeds.size());
+            std::vector<InputType> found;
+            for (const auto& [name, seedInput] : seeds) {
+                const Tracing::Span span(name, "stress");
+                InputType           worst        = *seedInput;
+                const double        seedNs       = measureSolutionNs(solution, executor, worst);
+                double              worstNs      = seedNs;
+                int64_t             steps        = 0;
+                int64_t             improvements = 0;
+                const int64_t       startNs      = PerformanceCounterDetails::getCurrentNanoseconds();
+                while (PerformanceCounterDetails::getCurrentNanoseconds() - startNs < seedLimitNs) {
+                    InputType candidate = worst;
+                    for (int i = 1 + int(rng() % 4); i > 0; --i)
+                        candidate.mutate(rng);
+                    const double candidateNs = measureSolutionNs(solution, executor, candidate);
+                    steps++;
+                    if (candidateNs > worstNs) {
+                        worst   = std::move(candidate);
+                        worstNs = candidateNs;
+                        improvements++;
+                    }
+                }
+                // measure again, as accepted steps are biased towards lucky (noisy) measurements.
+                worstNs               = improvements ? measureSolutionNs(solution, executor, worst) : seedNs;
+                const double slowdown = worstNs / std::max(seedNs, 1.0);
+                logger << "Case " << name << std::fixed << std::setprecision(3) << ": " << seedNs / 1000 << " us. -> "
+                       << worstNs / 1000 << " us. (x" << std::setprecision(2) << slowdown << ")" << std::defaultfloat
+                       << ", steps: " << steps << ", improvements: " << improvements << "\n";
+                if (slowdown >= minSlowdown)
+                    found.push_back(std::move(worst));
+            }
+            if (found.empty()) {
+                logger << "No inputs found that are " << minSlowdown << " times slower than test cases.\n"
+                       << std::flush;
+                return true;
+            }
+
+            const std::filesystem::path dir = std::filesystem::path(params.m_stressDir) / s_problemName;
+            std::filesystem::create_directories(dir);
+            int index = 0;
+            for (const InputType& input : found) {
+                while (std::filesystem::exists(dir / ("input_" + std::to_string(index) + ".txt")))
+                    index++;
+                const std::string suffix = std::to_string(index) + ".txt";
+                std::ofstream     inputFile(dir / ("input_" + suffix));
+                std::ofstream     outputFile(dir / ("output_" + suffix));
+                input.writeTo(inputFile);
+                solution(input, executor).writeTo(outputFile);
+                logger << "Saved " << (dir / ("input_" + suffix)).string() << "\n";
+            }
+            logger << std::flush;
+            return true;
+        }
+    }
 };
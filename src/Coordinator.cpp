@@ -0,0 +1,434 @@
+/*
+ * Copyright (C) 2025 Smirnov Vladimir / mapron1@gmail.com
+ * SPDX-License-Identifier: CC0-1.0
+ * See LICENSE file for details.
+ */
+#include "Coordinator.h"
+#include "CommonTestUtils.h"
+#include "PluginLoader.h"
+#include "Server.h"
+#include "SocketUtils.h"
+
+#include <deque>
+#include <iostream>
+#include <sstream>
+
+#ifndef _WIN32
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#endif
+
+#ifndef _WIN32
+namespace {
+
+constexpr int     g_maxAttempts    = 3;
+constexpr int64_t g_helloTimeoutNs = 10'000'000'000; // connection that does not introduce itself is closed.
+
+/// Options that define set of units or coordinator itself; they are not passed to units.
+const std::set<std::string> g_coordinatorOptions{
+    "problem",
+    "student",
+    "impl",
+    "shard",
+    "source",
+    "workers",
+    "unit-timeout",
+    "listen",
+    "connect",
+    "log-to",
+    "print-to",
+    "plugins",
+    "socket",
+    "test-input",
+    "test-output",
+    "trace-file",
+    "unit",
+};
+
+/// Options applied before test data is loaded, so they are given to local workers when they start instead of with units.
+const std::set<std::string> g_startupOptions{
+    "test-arena",
+    "test-arena-huge-pages",
+    "test-arena-prefault",
+    "test-arena-willneed",
+    "test-arena-lock",
+    "hash-outputs-above",
+    "calibration-file",
+};
+
+struct UnitState {
+    AbstractProblemData::WorkUnit m_unit;
+    int                           m_attempts = 0;
+    bool                          m_done     = false;
+    bool                          m_success  = false;
+    std::string                   m_log;
+    std::string                   m_workerName;
+};
+
+/// Connections are read without blocking, so silent or slow peer does not stop coordinator; partial data is kept in m_buffer.
+struct PendingConnection {
+    int         m_fd       = -1;
+    int64_t     m_acceptNs = 0;
+    std::string m_buffer;
+};
+
+struct WorkerConnection {
+    int         m_fd = -1;
+    std::string m_name;
+    int         m_unitIndex  = -1; // -1 when idle.
+    int64_t     m_dispatchNs = 0;  // when current unit was sent.
+    pid_t       m_pid        = -1; // local worker process, it is killed if unit times out.
+    std::string m_buffer;          // received part of unit result.
+};
+
+enum class ResultState {
+    Incomplete,
+    Complete,
+    Malformed,
+};
+
+/// Takes "status size\nlog" unit result from the beginning of buffer, if it is fully received.
+ResultState takeResult(std::string& buffer, int& status, std::string& log)
+{
+    const size_t headerEnd = buffer.find('\n');
+    if (headerEnd == std::string::npos)
+        return ResultState::Incomplete;
+    size_t size = 0;
+    if (!(std::istringstream(buffer.substr(0, headerEnd)) >> status >> size))
+        return ResultState::Malformed;
+    if (buffer.size() - headerEnd - 1 < size)
+        return ResultState::Incomplete;
+    log = buffer.substr(headerEnd + 1, size);
+    buffer.erase(0, headerEnd + 1 + size);
+    return ResultState::Complete;
+}
+
+std::string getHostName()
+{
+    char buffer[256] = {};
+    ::gethostname(buffer, sizeof(buffer) - 1);
+    return buffer;
+}
+
+pid_t spawnLocalWorker(const std::string& executable, int port, const CLIParams& params)
+{
+    std::vector<std::string> args{ executable, "--connect", "127.0.0.1:" + std::to_string(port), "--log-to", "stderr" };
+    if (!params.m_pluginPaths.empty()) {
+        std::string plugins;
+        for (const auto& path : params.m_pluginPaths)
+            plugins += (plugins.empty() ? "" : ",") + path;
+        args.insert(args.end(), { "--plugins", plugins });
+    }
+    for (const auto& [option, value] : params.m_parsedArgs) {
+        if (g_startupOptions.contains(option))
+            args.insert(args.end(), { "--" + option, value });
+    }
+    const pid_t pid = ::fork();
+    if (pid != 0)
+        return pid;
+
+    std::vector<char*> argv;
+    for (auto& arg : args)
+        argv.push_back(arg.data());
+    argv.push_back(nullptr);
+    ::execv(executable.c_str(), argv.data());
+    ::_exit(127);
+}
+
+std::vector<std::string> makeUnitArgs(const std::vector<std::string>& forwardedArgs, const AbstractProblemData::WorkUnit& unit)
+{
+    // names may contain glob, regex or list characters, so they are not passed as filters.
+    std::vector<std::string> args = forwardedArgs;
+    args.push_back("--unit");
+    args.push_back(std::string(unit.m_problemName) + '\t' + std::string(unit.m_studentName) + '\t'
+                   + std::string(unit.m_implName) + '\t' + std::string(unit.m_sourceName));
+    return args;
+}
+
+}
+
+namespace Coordinator {
+
+bool runCoordinator(const CLIParams& params)
+{
+    std::ostream& logger = *params.m_loggingStream;
+
+    // options as parser paired them, so forwarded command line is exactly what this process accepted.
+    std::vector<std::string> forwardedArgs;
+    for (const auto& [option, value] : params.m_parsedArgs) {
+        if (!g_coordinatorOptions.contains(option) && !g_startupOptions.contains(option))
+            forwardedArgs.insert(forwardedArgs.end(), { "--" + option, value });
+    }
+
+    std::vector<UnitState> units;
+    for (const auto& unit : AbstractProblemData::listAllWorkUnits(params)) {
+        UnitState& state = units.emplace_back();
+        state.m_unit     = unit;
+    }
+    if (units.empty()) {
+        logger << "No work units match the filters.\n";
+        return true;
+    }
+
+    std::string error;
+    int         port     = 0;
+    const int   listenFd = SocketUtils::listenTcp(params.m_listenAddress, port, error);
+    if (listenFd < 0) {
+        logger << "Coordinator failed to start: " << error << "\n";
+        return false;
+    }
+    logger << "Coordinator is listening on port " << port << ", " << units.size() << " work units, "
+           << params.m_workerCount << " local workers.\n"
+           << std::flush;
+
+    const std::string executable = PluginLoader::getArtifactPath(0);
+    const std::string localHost  = getHostName();
+    std::set<pid_t>   localWorkers;
+    for (int i = 0; i < params.m_workerCount; ++i)
+        localWorkers.insert(spawnLocalWorker(executable, port, params));
+    int respawnBudget = params.m_workerCount * g_maxAttempts;
+
+    PerformanceCounter             topCounter(Perf::ExecTime);
+    std::deque<int>                queue;
+    std::vector<PendingConnection> pending;
+    std::vector<WorkerConnection>  workers;
+    size_t                        doneCount    = 0;
+    size_t                        retryCount   = 0;
+    size_t                        totalWorkers = 0;
+    for (int i = 0; i < (int) units.size(); ++i)
+        queue.push_back(i);
+
+    auto dispatch = [&](WorkerConnection& worker) {
+        if (queue.empty())
+            return;
+        worker.m_unitIndex = queue.front();
+        queue.pop_front();
+        UnitState& state = units[worker.m_unitIndex];
+        state.m_attempts++;
+        worker.m_dispatchNs = PerformanceCounterDetails::getCurrentNanoseconds();
+        SocketUtils::writeAll(worker.m_fd, "RUN\n" + SocketUtils::encodeArgs(makeUnitArgs(forwardedArgs, state.m_unit)));
+    };
+    auto dropWorker = [&](size_t index, const char* reason) {
+        WorkerConnection worker = workers[index];
+        workers.erase(workers.begin() + index);
+        SocketUtils::closeSocket(worker.m_fd);
+        if (worker.m_unitIndex < 0)
+            return;
+        UnitState& state = units[worker.m_unitIndex];
+        logger << "Worker " << worker.m_name << " " << reason << " while running unit #" << worker.m_unitIndex << ".\n"
+               << std::flush;
+        if (state.m_attempts < g_maxAttempts) {
+            retryCount++;
+            queue.push_front(worker.m_unitIndex);
+            return;
+        }
+        state.m_done    = true;
+        state.m_log     = "Unit failed: worker was lost or timed out " + std::to_string(state.m_attempts) + " times.\n";
+        state.m_success = false;
+        doneCount++;
+    };
+
+    while (doneCount < units.size()) {
+        // replace crashed local workers, so remaining work still has someone to run it.
+        for (int status = 0; const pid_t pid = ::waitpid(-1, &status, WNOHANG);) {
+            if (pid <= 0)
+                break;
+            localWorkers.erase(pid);
+            if (respawnBudget-- > 0)
+                localWorkers.insert(spawnLocalWorker(executable, port, params));
+        }
+        if (localWorkers.empty() && workers.empty() && params.m_workerCount > 0 && respawnBudget <= 0) {
+            logger << "All local workers failed, aborting.\n";
+            break;
+        }
+
+        // hung worker (endless solution, stuck remote host) is dropped like a lost one; local process is killed,
+        // so it is restarted above. Remote worker has to be restarted by its owner.
+        const int64_t nowNs = PerformanceCounterDetails::getCurrentNanoseconds();
+        for (size_t i = workers.size(); i-- > 0;) {
+            const WorkerConnection& worker = workers[i];
+            if (worker.m_unitIndex < 0 || params.m_unitTimeoutS <= 0 || nowNs - worker.m_dispatchNs < params.m_unitTimeoutS * 1'000'000'000LL)
+                continue;
+            if (worker.m_pid > 0)
+                ::kill(worker.m_pid, SIGKILL);
+            dropWorker(i, "timed out");
+        }
+
+        // units of lost workers are returned to queue, idle workers pick them up.
+        for (auto& worker : workers) {
+            if (worker.m_unitIndex < 0)
+                dispatch(worker);
+        }
+
+        // poll order: listening socket, pending connections, workers.
+        std::vector<pollfd> pfds{ { .fd = listenFd, .events = POLLIN, .revents = 0 } };
+        for (const auto& connection : pending)
+            pfds.push_back({ .fd = connection.m_fd, .events = POLLIN, .revents = 0 });
+        for (const auto& worker : workers)
+            pfds.push_back({ .fd = worker.m_fd, .events = POLLIN, .revents = 0 });
+        if (::poll(pfds.data(), pfds.size(), 500) < 0 && errno != EINTR) {
+            logger << "poll() failed: " << std::strerror(errno) << "\n";
+            break;
+        }
+        const size_t workersOffset = 1 + pending.size();
+
+        // iterate backwards as lost workers are removed; new workers are added only after this loop.
+        for (size_t i = workers.size(); i-- > 0;) {
+            if (!pfds[workersOffset + i].revents)
+                continue;
+            // result is taken even if worker closed connection right after sending it.
+            WorkerConnection& worker = workers[i];
+            const bool        isOpen = SocketUtils::readAvailable(worker.m_fd, worker.m_buffer);
+            std::string       log;
+            int               status = 0;
+            const ResultState result = takeResult(worker.m_buffer, status, log);
+            if (result == ResultState::Malformed || (result == ResultState::Complete && worker.m_unitIndex < 0)) {
+                dropWorker(i, "sent malformed result");
+                continue;
+            }
+            if (result == ResultState::Incomplete) {
+                if (!isOpen)
+                    dropWorker(i, "lost");
+                continue;
+            }
+            UnitState& state   = units[worker.m_unitIndex];
+            state.m_done       = true;
+            state.m_success    = status == 0;
+            state.m_log        = std::move(log);
+            state.m_workerName = worker.m_name;
+            worker.m_unitIndex = -1;
+            doneCount++;
+            logger << "[" << doneCount << "/" << units.size() << "] " << state.m_unit.m_problemName << "/"
+                   << state.m_unit.m_studentName << "/" << state.m_unit.m_implName << "/" << state.m_unit.m_sourceName
+                   << (state.m_success ? " passed" : " FAILED") << " on " << state.m_workerName << "\n"
+                   << std::flush;
+            if (!isOpen) {
+                dropWorker(i, "lost");
+                continue;
+            }
+            dispatch(worker);
+        }
+
+        for (size_t i = pending.size(); i-- > 0;) {
+            PendingConnection& connection = pending[i];
+            const bool         isOpen     = !pfds[1 + i].revents || SocketUtils::readAvailable(connection.m_fd, connection.m_buffer);
+            const size_t       lineEnd    = connection.m_buffer.find('\n');
+            if (lineEnd == std::string::npos) {
+                if (!isOpen || nowNs - connection.m_acceptNs > g_helloTimeoutNs) {
+                    SocketUtils::closeSocket(connection.m_fd);
+                    pending.erase(pending.begin() + i);
+                }
+                continue;
+            }
+            const std::string hello = connection.m_buffer.substr(0, lineEnd);
+            if (!isOpen || !hello.starts_with("HELLO ")) {
+                SocketUtils::closeSocket(connection.m_fd);
+                pending.erase(pending.begin() + i);
+                continue;
+            }
+            WorkerConnection& worker = workers.emplace_back();
+            worker.m_fd              = connection.m_fd;
+            worker.m_name            = hello.substr(6);
+            worker.m_buffer          = connection.m_buffer.substr(lineEnd + 1);
+            // worker name is "host/pid", see runWorker().
+            const size_t slash = worker.m_name.rfind('/');
+            if (slash != std::string::npos && worker.m_name.substr(0, slash) == localHost) {
+                const pid_t pid = std::atoi(worker.m_name.c_str() + slash + 1);
+                if (localWorkers.contains(pid))
+                    worker.m_pid = pid;
+            }
+            pending.erase(pending.begin() + i);
+            totalWorkers++;
+            dispatch(workers.back());
+        }
+
+        if (pfds[0].revents & POLLIN) {
+            const int fd = SocketUtils::acceptConnection(listenFd);
+            if (fd >= 0)
+                pending.push_back({ .m_fd = fd, .m_acceptNs = PerformanceCounterDetails::getCurrentNanoseconds(), .m_buffer = {} });
+        }
+    }
+
+    for (const auto& worker : workers) {
+        SocketUtils::writeAll(worker.m_fd, "DONE\n");
+        SocketUtils::closeSocket(worker.m_fd);
+    }
+    for (const auto& connection : pending)
+        SocketUtils::closeSocket(connection.m_fd);
+    SocketUtils::closeSocket(listenFd);
+    for (const pid_t pid : localWorkers)
+        ::waitpid(pid, nullptr, 0);
+
+    size_t failedCount = 0;
+    logger << "\n";
+    for (const UnitState& state : units) {
+        if (!state.m_done || !state.m_success)
+            failedCount++;
+        logger << "=== " << state.m_unit.m_problemName << "/" << state.m_unit.m_studentName << "/"
+               << state.m_unit.m_implName << "/" << state.m_unit.m_sourceName;
+        if (!state.m_done) {
+            logger << ": not executed.\n";
+            continue;
+        }
+        logger << " (" << state.m_workerName << ", attempt " << state.m_attempts << ")\n"
+               << state.m_log;
+    }
+    logger << "Distributed run finished, units: " << units.size() << ", failed: " << failedCount
+           << ", retried: " << retryCount << ", workers: " << totalWorkers;
+    topCounter.printTo(logger, true);
+    return failedCount == 0;
+}
+
+bool runWorker(const CLIParams& params)
+{
+    std::ostream& logger = *params.m_loggingStream;
+    std::string   error;
+    const int     fd = SocketUtils::connectTcp(params.m_connectAddress, error);
+    if (fd < 0) {
+        logger << "Worker failed to start: " << error << "\n";
+        return false;
+    }
+    const std::string name = getHostName() + "/" + std::to_string(::getpid());
+    SocketUtils::writeAll(fd, "HELLO " + name + "\n");
+
+    std::string command;
+    while (SocketUtils::readLine(fd, command) && command == "RUN") {
+        std::vector<std::string> args;
+        if (!SocketUtils::readArgs(fd, args))
+            break;
+        std::ostringstream response;
+        const bool         success = Server::executeRequest(args, response, nullptr);
+        const std::string  log     = response.str();
+        if (!SocketUtils::writeAll(fd, std::to_string(success ? 0 : 1) + " " + std::to_string(log.size()) + "\n" + log))
+            break;
+    }
+    SocketUtils::closeSocket(fd);
+    return true;
+}
+
+}
+
+#else
+
+namespace Coordinator {
+
+bool runCoordinator(const CLIParams& params)
+{
+    *params.m_loggingStream << "Distributed runs are not supported on this platform.\n";
+    return false;
+}
+
+bool runWorker(const CLIParams& params)
+{
+    *params.m_loggingStream << "Distributed runs are not supported on this platform.\n";
+    return false;
+}
+
+}
+
+#endif
@@ -0,0 +1,21 @@
+/*
+ * Copyright (C) 2025 Smirnov Vladimir / mapron1@gmail.com
+ * SPDX-License-Identifier: CC0-1.0
+ * See LICENSE file for details.
+ */
+#pragma once
+
+#include "CommandLine.h"
+
+/// Distributed runs: coordinator splits work into (problem, solution, test source) units
+/// and hands them to worker processes over TCP, whichever worker is free gets the next unit.
+namespace Coordinator {
+
+/// Start params.m_workerCount local workers (more can connect to params.m_listenAddress),
+/// run all units and print merged report. Returns false if any unit failed.
+bool runCoordinator(const CLIParams& params);
+
+/// Connect to coordinator at params.m_connectAddress and execute units until coordinator says it is done.
+bool runWorker(const CLIParams& params);
+
+}
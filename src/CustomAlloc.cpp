@@ -4,38 +4,99 @@
  * See LICENSE file for details.
  */
 #include "CustomAlloc.h"
+#include "TestArena.h"
 
 #include <malloc.h>
 
+#include <atomic>
+#include <new>
+
 namespace {
-CustomAlloc::Info s_newInfo{};
-CustomAlloc::Info s_deleteInfo{};
+/// Counters are updated from solution threads too, so they are atomic; relaxed order is enough for statistics.
+struct AtomicInfo {
+    std::atomic<uint64_t> m_calls{ 0 };
+    std::atomic<uint64_t> m_totalBytes{ 0 };
+    std::atomic<uint64_t> m_timeSpentNanosec{ 0 };
+
+    CustomAlloc::Info load() const
+    {
+        return CustomAlloc::Info{
+            .m_calls            = m_calls.load(std::memory_order_relaxed),
+            .m_totalBytes       = m_totalBytes.load(std::memory_order_relaxed),
+            .m_timeSpentNanosec = m_timeSpentNanosec.load(std::memory_order_relaxed),
+        };
+    }
+};
+AtomicInfo s_newInfo;
+AtomicInfo s_deleteInfo;
 }
 namespace CustomAlloc {
 Info getNewInfo()
 {
-    return s_newInfo;
+    return s_newInfo.load();
 }
 Info getDeleteInfo()
 {
-    return s_deleteInfo;
+    return s_deleteInfo.load();
+}
+bool isHookEnabled()
+{
+    return true;
 }
 }
 
 void* operator new(decltype(sizeof(0)) n) noexcept(false)
 {
-    s_newInfo.m_calls++;
-    s_newInfo.m_totalBytes += n;
+    s_newInfo.m_calls.fetch_add(1, std::memory_order_relaxed);
+    s_newInfo.m_totalBytes.fetch_add(n, std::memory_order_relaxed);
     int64_t startNS = PerformanceCounterDetails::getCurrentNanoseconds();
-    void*   result  = malloc(n);
-    s_newInfo.m_timeSpentNanosec += PerformanceCounterDetails::getCurrentNanoseconds() - startNS;
+    void*   result  = TestArena::tryAllocate(n);
+    if (!result)
+        result = malloc(n);
+    s_newInfo.m_timeSpentNanosec.fetch_add(PerformanceCounterDetails::getCurrentNanoseconds() - startNS, std::memory_order_relaxed);
     return result;
 }
 
 void operator delete(void* p) throw()
 {
-    s_deleteInfo.m_calls++;
+    s_deleteInfo.m_calls.fetch_add(1, std::memory_order_relaxed);
+    int64_t startNS = PerformanceCounterDetails::getCurrentNanoseconds();
+    if (!TestArena::owns(p))
+        free(p);
+    s_deleteInfo.m_timeSpentNanosec.fetch_add(PerformanceCounterDetails::getCurrentNanoseconds() - startNS, std::memory_order_relaxed);
+}
+
+/// Used by over-aligned types and Details::AlignedAllocator. Arena blocks of 64 bytes and more are already cache line aligned.
+void* operator new(decltype(sizeof(0)) n, std::align_val_t align) noexcept(false)
+{
+    s_newInfo.m_calls.fetch_add(1, std::memory_order_relaxed);
+    s_newInfo.m_totalBytes.fetch_add(n, std::memory_order_relaxed);
+    int64_t      startNS   = PerformanceCounterDetails::getCurrentNanoseconds();
+    const size_t alignment = static_cast<size_t>(align);
+    void*        result    = alignment <= 64 && n >= 64 ? TestArena::tryAllocate(n) : nullptr;
+    if (!result) {
+#ifdef _WIN32
+        result = _aligned_malloc(n, alignment);
+#else
+        result = aligned_alloc(alignment, (n + alignment - 1) / alignment * alignment);
+#endif
+    }
+    s_newInfo.m_timeSpentNanosec.fetch_add(PerformanceCounterDetails::getCurrentNanoseconds() - startNS, std::memory_order_relaxed);
+    if (!result)
+        throw std::bad_alloc();
+    return result;
+}
+
+void operator delete(void* p, std::align_val_t) throw()
+{
+    s_deleteInfo.m_calls.fetch_add(1, std::memory_order_relaxed);
     int64_t startNS = PerformanceCounterDetails::getCurrentNanoseconds();
-    free(p);
-    s_deleteInfo.m_timeSpentNanosec += PerformanceCounterDetails::getCurrentNanoseconds() - startNS;
+    if (!TestArena::owns(p)) {
+#ifdef _WIN32
+        _aligned_free(p);
+#else
+        free(p);
+#endif
+    }
+    s_deleteInfo.m_timeSpentNanosec.fetch_add(PerformanceCounterDetails::getCurrentNanoseconds() - startNS, std::memory_order_relaxed);
 }
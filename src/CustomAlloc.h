@@ -30,4 +30,7 @@ struct Info {
 Info getNewInfo();
 Info getDeleteInfo();
 
+/// False when ENABLE_NEW_DELETE_HOOK is OFF, so calls are not counted and infos are always zero.
+bool isHookEnabled();
+
 }
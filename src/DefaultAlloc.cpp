@@ -18,4 +18,8 @@ Info getDeleteInfo()
 {
     return s_deleteInfo;
 }
+bool isHookEnabled()
+{
+    return false;
+}
 }
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2025 Smirnov Vladimir / mapron1@gmail.com
+ * SPDX-License-Identifier: CC0-1.0
+ * See LICENSE file for details.
+ */
+#include "ParallelExecutor.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct ParallelExecutor::Impl {
+    /// State of one run(). Workers hold it by shared_ptr and take indices only from the job they picked up,
+    /// so a worker that wakes late sees an exhausted counter of old job and never touches task of a newer one.
+    struct Job {
+        const std::function<void(size_t)>* m_task      = nullptr;
+        size_t                             m_taskCount = 0;
+        std::atomic<size_t>                m_nextTask{ 0 };
+        size_t                             m_doneTasks = 0; // guarded by Impl::m_mutex.
+
+        /// Take tasks until there are none left; returns how many were done.
+        /// Task pointer is used only for index below m_taskCount, and run() waits for all of them, so it is still alive then.
+        size_t work()
+        {
+            size_t done = 0;
+            for (size_t index = m_nextTask++; index < m_taskCount; index = m_nextTask++) {
+                (*m_task)(index);
+                done++;
+            }
+            return done;
+        }
+    };
+
+    std::vector<std::thread> m_threads;
+
+    std::mutex              m_mutex;
+    std::condition_variable m_wakeUp;
+    std::condition_variable m_finished;
+    uint64_t                m_generation = 0; // incremented for every run(), so workers do not take the same job twice.
+    bool                    m_stop       = false;
+    std::shared_ptr<Job>    m_job;
+
+    void workerLoop()
+    {
+        uint64_t seenGeneration = 0;
+        while (true) {
+            std::shared_ptr<Job> job;
+            {
+                std::unique_lock lock(m_mutex);
+                m_wakeUp.wait(lock, [this, seenGeneration] { return m_stop || m_generation != seenGeneration; });
+                if (m_stop)
+                    return;
+                seenGeneration = m_generation;
+                job            = m_job;
+            }
+            if (!job)
+                continue;
+            const size_t done = job->work();
+            if (!done)
+                continue;
+
+            std::lock_guard lock(m_mutex);
+            job->m_doneTasks += done;
+            if (job->m_doneTasks == job->m_taskCount)
+                m_finished.notify_all();
+        }
+    }
+};
+
+ParallelExecutor::ParallelExecutor(int threadCount)
+    : m_impl(std::make_unique<Impl>())
+    , m_threadCount(threadCount > 0 ? threadCount : getDefaultThreadCount())
+{
+    for (int i = 1; i < m_threadCount; ++i)
+        m_impl->m_threads.emplace_back([impl = m_impl.get()] { impl->workerLoop(); });
+}
+
+ParallelExecutor::~ParallelExecutor()
+{
+    {
+        std::lock_guard lock(m_impl->m_mutex);
+        m_impl->m_stop = true;
+    }
+    m_impl->m_wakeUp.notify_all();
+    for (std::thread& thread : m_impl->m_threads)
+        thread.join();
+}
+
+void ParallelExecutor::run(size_t taskCount, const std::function<void(size_t)>& task) const
+{
+    if (taskCount == 0)
+        return;
+    if (m_impl->m_threads.empty() || taskCount == 1) {
+        for (size_t index = 0; index < taskCount; ++index)
+            task(index);
+        return;
+    }
+    auto job         = std::make_shared<Impl::Job>();
+    job->m_task      = &task;
+    job->m_taskCount = taskCount;
+    {
+        std::lock_guard lock(m_impl->m_mutex);
+        m_impl->m_job = job;
+        m_impl->m_generation++;
+    }
+    m_impl->m_wakeUp.notify_all();
+
+    const size_t     done = job->work();
+    std::unique_lock lock(m_impl->m_mutex);
+    job->m_doneTasks += done;
+    m_impl->m_finished.wait(lock, [&job] { return job->m_doneTasks == job->m_taskCount; });
+    m_impl->m_job.reset();
+}
+
+int ParallelExecutor::getDefaultThreadCount()
+{
+    return std::max(1, int(std::thread::hardware_concurrency()));
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2025 Smirnov Vladimir / mapron1@gmail.com
+ * SPDX-License-Identifier: CC0-1.0
+ * See LICENSE file for details.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+/// Thread pool passed to parallel solutions:
+///     Output solution(const Input& input, const ParallelExecutor& executor)
+/// Threads are created by checker before measurement, so solution pays only for task dispatch.
+/// Thread count is a hint: solution may split work into any number of tasks.
+class ParallelExecutor {
+public:
+    /// Non-positive count means getDefaultThreadCount().
+    explicit ParallelExecutor(int threadCount);
+    ~ParallelExecutor();
+    ParallelExecutor(const ParallelExecutor&)            = delete;
+    ParallelExecutor& operator=(const ParallelExecutor&) = delete;
+
+    int getThreadCount() const { return m_threadCount; }
+
+    /// Call task(index) for every index in [0, taskCount), calling thread takes part too. Blocks until all tasks are done.
+    /// Must not be called recursively from a task.
+    void run(size_t taskCount, const std::function<void(size_t)>& task) const;
+
+    /// Split [0, size) into getThreadCount() contiguous ranges and call func(begin, end, rangeIndex) for each in parallel.
+    template<class Func>
+    void forEachRange(size_t size, Func&& func) const
+    {
+        const size_t rangeCount = std::max<size_t>(1, std::min<size_t>(m_threadCount, size));
+        run(rangeCount, [&func, size, rangeCount](size_t index) {
+            func(size * index / rangeCount, size * (index + 1) / rangeCount, index);
+        });
+    }
+
+    /// Default when '--threads' is not set: std::thread::hardware_concurrency().
+    static int getDefaultThreadCount();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+    int                   m_threadCount = 1;
+};
@@ -15,6 +15,8 @@
 #define _WIN32_WINNT 0x0A00
 #include <Windows.h>
 #include <psapi.h>
+#else
+#include <sys/resource.h>
 #endif
 
 namespace PerformanceCounterDetails {
@@ -47,6 +49,17 @@ int64_t getPeakBytes()
     GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
     return counters.PeakWorkingSetSize;
 }
+/// Windows counts soft and hard faults together, so all of them are reported as minor.
+uint64_t getMinorFaults()
+{
+    PROCESS_MEMORY_COUNTERS counters;
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+    return counters.PageFaultCount;
+}
+uint64_t getMajorFaults()
+{
+    return 0;
+}
 
 #else
 int64_t getCurrentCpuTime()
@@ -57,6 +70,18 @@ int64_t getPeakBytes()
 {
     return 0;
 }
+uint64_t getMinorFaults()
+{
+    rusage usage{};
+    ::getrusage(RUSAGE_SELF, &usage);
+    return uint64_t(usage.ru_minflt);
+}
+uint64_t getMajorFaults()
+{
+    rusage usage{};
+    ::getrusage(RUSAGE_SELF, &usage);
+    return uint64_t(usage.ru_majflt);
+}
 #endif
 
 /// Current precision clock in microseconds
@@ -114,6 +139,14 @@ void PerformanceCounter::start(Perf p)
             m_startNewElapsedNs    = CustomAlloc::getNewInfo().m_timeSpentNanosec;
             m_startDeleteElapsedNs = CustomAlloc::getDeleteInfo().m_timeSpentNanosec;
         } break;
+        case MinorFaults:
+        {
+            m_startMinorFaults = getMinorFaults();
+        } break;
+        case MajorFaults:
+        {
+            m_startMajorFaults = getMajorFaults();
+        } break;
     }
 }
 
@@ -122,6 +155,11 @@ bool PerformanceCounter::isTimedOut(int64_t executionLimit) const
     return getCurrentMicroseconds() > (m_startUS + executionLimit);
 }
 
+int64_t PerformanceCounter::getElapsedUS() const
+{
+    return getCurrentMicroseconds() - m_startUS;
+}
+
 void PerformanceCounter::printTo(std::ostream& os, bool addNewLine)
 {
     if (m_enableExecTime) {
@@ -154,6 +192,10 @@ void PerformanceCounter::printTo(std::ostream& os, bool addNewLine)
         const auto info    = CustomAlloc::getDeleteInfo() - CustomAlloc::Info{ m_startDeleteCalls, 0, m_startDeleteElapsedNs };
         os << ", percent of time in new+delete: " << ((ns / 10) / elapsed) << "%";
     }
+    if (m_enableMinorFaults)
+        os << ", minor page faults: " << (getMinorFaults() - m_startMinorFaults);
+    if (m_enableMajorFaults)
+        os << ", major page faults: " << (getMajorFaults() - m_startMajorFaults);
     if (addNewLine)
         os << "\n"
            << std::flush;
@@ -19,6 +19,9 @@ enum class Perf
     DeleteCalls,
 
     TimeSpentAlloc,
+
+    MinorFaults, // page faults served without IO: first touch of a page, copy-on-write.
+    MajorFaults, // page faults that read from disk: swapped out or file-backed memory.
 };
 namespace PerformanceCounterDetails {
 int64_t getCurrentNanoseconds();
@@ -36,7 +39,8 @@ public:
         enablePerf(ps);
     }
 
-    bool isTimedOut(int64_t executionLimit) const;
+    bool    isTimedOut(int64_t executionLimit) const;
+    int64_t getElapsedUS() const;
     void printTo(std::ostream& os, bool addNewLine);
 
     template<size_t N>
@@ -69,6 +73,12 @@ public:
             case TimeSpentAlloc:
                 flag = &m_enableTimeSpentAlloc;
                 break;
+            case MinorFaults:
+                flag = &m_enableMinorFaults;
+                break;
+            case MajorFaults:
+                flag = &m_enableMajorFaults;
+                break;
         }
         if (*flag)
             return;
@@ -88,6 +98,8 @@ private:
     uint64_t m_startNewElapsedNs    = 0;
     uint64_t m_startDeleteCalls     = 0;
     uint64_t m_startDeleteElapsedNs = 0;
+    uint64_t m_startMinorFaults     = 0;
+    uint64_t m_startMajorFaults     = 0;
 
     bool m_enableExecTime       = false;
     bool m_enableCpuClock       = false;
@@ -95,4 +107,6 @@ private:
     bool m_enableNewCalls       = false;
     bool m_enableDeleteCalls    = false;
     bool m_enableTimeSpentAlloc = false;
+    bool m_enableMinorFaults    = false;
+    bool m_enableMajorFaults    = false;
 };
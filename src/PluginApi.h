@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2025 Smirnov Vladimir / mapron1@gmail.com
+ * SPDX-License-Identifier: CC0-1.0
+ * See LICENSE file for details.
+ */
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/// Binary interface between ContestChecker and solutions built as shared libraries.
+/// Plugin does not link with checker; all calls go through Registrar function pointers.
+namespace PluginApi {
+
+using GenericFunction = void (*)();
+
+struct Registrar {
+    void* m_context = nullptr;
+
+    /// signature is typeid(&solution).name(), it must match solution type expected by problem.
+    /// abiKey is makeAbiKey() result for problem Input/Output, it must match the key checker has for the problem.
+    void (*m_registerSolution)(void*           context,
+                               const char*     problemName,
+                               const char*     signature,
+                               const char*     abiKey,
+                               GenericFunction function,
+                               const char*     implName,
+                               const char*     studentName)
+        = nullptr;
+};
+
+using EntryPoint = void (*)(const Registrar* registrar);
+
+/// Changed together with Registrar, so plugins built for older interface are reported as having no entry point.
+constexpr const char* g_entryPointName = "contestCheckerRegisterSolutionsV2";
+
+/// Type names in signature do not change when members of Input/Output change, so plugin built against older problem header
+/// would still match it. Key adds layout of the types, hash of headers which define them (computed by CMake)
+/// and compiler settings which change layout of standard containers.
+template<class Input, class Output>
+std::string makeAbiKey(const char* headersHash)
+{
+    std::string key = headersHash;
+    for (size_t value : { sizeof(Input), alignof(Input), sizeof(Output), alignof(Output) })
+        key += "|" + std::to_string(value);
+#if defined(__VERSION__)
+    key += "|" __VERSION__;
+#elif defined(_MSC_FULL_VER)
+    key += "|msvc " + std::to_string(_MSC_FULL_VER);
+#endif
+#if defined(_GLIBCXX_DEBUG) || (defined(_ITERATOR_DEBUG_LEVEL) && _ITERATOR_DEBUG_LEVEL > 0)
+    key += "|debug iterators";
+#endif
+    return key;
+}
+
+}
+
+#ifdef _WIN32
+#define CONTEST_CHECKER_PLUGIN_EXPORT extern "C" __declspec(dllexport)
+#else
+#define CONTEST_CHECKER_PLUGIN_EXPORT extern "C" __attribute__((visibility("default")))
+#endif
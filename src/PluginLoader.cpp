@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2025 Smirnov Vladimir / mapron1@gmail.com
+ * SPDX-License-Identifier: CC0-1.0
+ * See LICENSE file for details.
+ */
+#include "PluginLoader.h"
+#include "CommonTestUtils.h"
+
+#include <filesystem>
+#include <iostream>
+#include <map>
+
+#ifdef _WIN32
+#define WINVER 0x0A00
+#define _WIN32_WINNT 0x0A00
+#include <Windows.h>
+#else
+#include <dlfcn.h>
+#include <unistd.h>
+
+#include <climits>
+#endif
+
+namespace {
+#ifdef _WIN32
+constexpr const char* g_pluginExtension = ".dll";
+#else
+constexpr const char* g_pluginExtension = ".so";
+#endif
+
+struct LoadedPlugin {
+    void*                           m_handle   = nullptr;
+    uint64_t                        m_pluginId = 0;
+    std::filesystem::file_time_type m_mtime;
+    uintmax_t                       m_size = 0;
+};
+
+std::map<uint64_t, std::string>& getPluginPaths()
+{
+    static std::map<uint64_t, std::string> s_paths;
+    return s_paths;
+}
+
+struct RegisterContext {
+    uint64_t      m_pluginId = 0;
+    std::string   m_path;
+    std::ostream* m_log     = nullptr;
+    bool          m_success = true;
+};
+
+void* openLibrary(const std::string& path, std::string& error)
+{
+#ifdef _WIN32
+    void* handle = (void*) LoadLibraryA(path.c_str());
+    if (!handle)
+        error = "LoadLibrary error " + std::to_string(GetLastError());
+#else
+    void* handle = ::dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!handle)
+        error = ::dlerror();
+#endif
+    return handle;
+}
+
+void* findSymbol(void* handle, const char* name)
+{
+#ifdef _WIN32
+    return (void*) GetProcAddress((HMODULE) handle, name);
+#else
+    return ::dlsym(handle, name);
+#endif
+}
+
+void closeLibrary(void* handle)
+{
+#ifdef _WIN32
+    FreeLibrary((HMODULE) handle);
+#else
+    ::dlclose(handle);
+#endif
+}
+
+void registerSolution(void*                      context,
+                      const char*                problemName,
+                      const char*                signature,
+                      const char*                abiKey,
+                      PluginApi::GenericFunction function,
+                      const char*                implName,
+                      const char*                studentName)
+{
+    auto&                                  ctx  = *static_cast<RegisterContext*>(context);
+    const AbstractProblemData::RunnerDesc* desc = AbstractProblemData::findProblemRunner(problemName);
+    if (!desc) {
+        *ctx.m_log << "Plugin '" << ctx.m_path << "' contains solution for unknown problem '" << problemName << "'.\n";
+        ctx.m_success = false;
+        return;
+    }
+    if (!desc->m_acceptPluginSolution(signature, abiKey, function, implName, studentName, ctx.m_pluginId)) {
+        *ctx.m_log << "Plugin '" << ctx.m_path << "' solution '" << implName
+                   << "' does not match Input/Output of problem '" << problemName << "', rebuild it.\n";
+        ctx.m_success = false;
+    }
+}
+
+void unload(LoadedPlugin& plugin)
+{
+    for (const auto& desc : AbstractProblemData::getProblemRunners())
+        desc.m_removePluginSolutions(plugin.m_pluginId);
+    getPluginPaths().erase(plugin.m_pluginId);
+    closeLibrary(plugin.m_handle);
+    plugin.m_handle = nullptr;
+}
+
+bool load(const std::string& path, LoadedPlugin& plugin, std::ostream& log)
+{
+    static uint64_t s_nextPluginId = 1;
+
+    std::string error;
+    void*       handle = openLibrary(path, error);
+    if (!handle) {
+        log << "Failed to load plugin '" << path << "': " << error << "\n";
+        return false;
+    }
+    auto entry = reinterpret_cast<PluginApi::EntryPoint>(findSymbol(handle, PluginApi::g_entryPointName));
+    if (!entry) {
+        log << "Plugin '" << path << "' has no '" << PluginApi::g_entryPointName << "' entry point.\n";
+        closeLibrary(handle);
+        return false;
+    }
+    plugin.m_handle   = handle;
+    plugin.m_pluginId = s_nextPluginId++;
+
+    getPluginPaths()[plugin.m_pluginId] = path;
+
+    RegisterContext      context{ plugin.m_pluginId, path, &log };
+    PluginApi::Registrar registrar{ &context, &registerSolution };
+    entry(&registrar);
+    if (!context.m_success) {
+        // other solutions of the plugin may be registered already, but it is rebuilt as a whole anyway.
+        unload(plugin);
+        log << "Plugin '" << path << "' is skipped.\n";
+    }
+    return context.m_success;
+}
+
+std::vector<std::filesystem::path> collectFiles(const std::vector<std::string>& paths)
+{
+    std::vector<std::filesystem::path> result;
+    for (const std::string& path : paths) {
+        std::error_code ec;
+        if (std::filesystem::is_directory(path, ec)) {
+            for (const auto& entry : std::filesystem::directory_iterator(path, ec)) {
+                if (entry.is_regular_file() && entry.path().extension() == g_pluginExtension)
+                    result.push_back(entry.path());
+            }
+        } else {
+            result.push_back(path);
+        }
+    }
+    return result;
+}
+
+}
+
+namespace PluginLoader {
+
+std::vector<std::string> getDefaultPaths()
+{
+#ifdef CONTEST_CHECKER_PLUGIN_DIR
+    return { CONTEST_CHECKER_PLUGIN_DIR };
+#else
+    return {};
+#endif
+}
+
+bool refresh(const std::vector<std::string>& paths, std::ostream& log)
+{
+    static std::map<std::filesystem::path, LoadedPlugin> s_loaded;
+
+    bool                                          result = true;
+    std::map<std::filesystem::path, LoadedPlugin> current;
+    for (const std::filesystem::path& path : collectFiles(paths.empty() ? getDefaultPaths() : paths)) {
+        std::error_code ec;
+        const auto      mtime = std::filesystem::last_write_time(path, ec);
+        const auto      size  = std::filesystem::file_size(path, ec);
+        if (ec) {
+            log << "Failed to access plugin '" << path.string() << "': " << ec.message() << "\n";
+            result = false;
+            continue;
+        }
+        auto it = s_loaded.find(path);
+        if (it != s_loaded.end()) {
+            LoadedPlugin plugin = it->second;
+            s_loaded.erase(it);
+            if (plugin.m_mtime == mtime && plugin.m_size == size) {
+                current[path] = plugin;
+                continue;
+            }
+            log << "Reloading changed plugin '" << path.string() << "'\n";
+            unload(plugin);
+        }
+        LoadedPlugin plugin{ .m_mtime = mtime, .m_size = size };
+        if (!load(path.string(), plugin, log))
+            result = false;
+        if (plugin.m_handle)
+            current[path] = plugin;
+    }
+    for (auto& [path, plugin] : s_loaded) {
+        log << "Unloading removed plugin '" << path.string() << "'\n";
+        unload(plugin);
+    }
+    s_loaded = std::move(current);
+    return result;
+}
+
+std::string getArtifactPath(uint64_t pluginId)
+{
+    if (pluginId) {
+        auto it = getPluginPaths().find(pluginId);
+        return it == getPluginPaths().end() ? std::string() : it->second;
+    }
+#ifdef _WIN32
+    char        buffer[MAX_PATH];
+    const DWORD size = GetModuleFileNameA(nullptr, buffer, MAX_PATH);
+#else
+    char       buffer[PATH_MAX];
+    const auto size = ::readlink("/proc/self/exe", buffer, sizeof(buffer) - 1);
+#endif
+    if (size <= 0)
+        return {};
+    return std::string(buffer, size);
+}
+
+}
@@ -0,0 +1,27 @@
+/*
+ * Copyright (C) 2025 Smirnov Vladimir / mapron1@gmail.com
+ * SPDX-License-Identifier: CC0-1.0
+ * See LICENSE file for details.
+ */
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/// Loading solutions built as separate shared libraries (see BUILD_SOLUTIONS_AS_PLUGINS CMake option).
+namespace PluginLoader {
+
+/// Plugin paths used when none are given in command line: plugin output dir of the build, if plugins are enabled.
+std::vector<std::string> getDefaultPaths();
+
+/// Synchronize loaded plugins with paths (files or directories with shared libraries); empty paths mean default ones.
+/// New files are loaded, changed files are reloaded and deleted files are unloaded; unchanged plugins are kept as is.
+/// Plugins that failed to load or register are reported to log and skipped; returns false if there were such plugins.
+bool refresh(const std::vector<std::string>& paths, std::ostream& log);
+
+/// File that contains code of solution: plugin library, or the executable itself for pluginId=0.
+std::string getArtifactPath(uint64_t pluginId);
+
+}
@@ -0,0 +1,405 @@
+/*
+ * Copyright (C) 2025 Smirnov Vladimir / mapron1@gmail.com
+ * SPDX-License-Identifier: CC0-1.0
+ * See LICENSE file for details.
+ */
+#include "Profiler.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#if defined(__linux__) && defined(__LP64__)
+#define CONTEST_CHECKER_PROFILER_SUPPORTED 1
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <elf.h>
+#include <execinfo.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+extern char** environ;
+#endif
+
+#ifdef CONTEST_CHECKER_PROFILER_SUPPORTED
+namespace {
+
+constexpr int    g_maxFrames      = 48;
+constexpr size_t g_maxSamples     = 30000;
+constexpr int    g_intervalUS     = 1000;
+constexpr int    g_skipFrames     = 2; // signal handler and signal trampoline.
+constexpr size_t g_maxFoldedDepth = 24;
+constexpr size_t g_maxNameLength  = 160; // template instantiations may be really long.
+
+struct Sample {
+    int   m_depth = 0;
+    void* m_frames[g_maxFrames];
+};
+
+Sample*             s_samples = nullptr;
+std::atomic<size_t> s_sampleCount{ 0 };
+
+void onProfSignal(int)
+{
+    const size_t index = s_sampleCount.fetch_add(1, std::memory_order_relaxed);
+    if (index >= g_maxSamples)
+        return;
+    const int savedErrno     = errno;
+    s_samples[index].m_depth = ::backtrace(s_samples[index].m_frames, g_maxFrames);
+    errno                    = savedErrno;
+}
+
+/// Function symbols of one ELF file (executable or shared library).
+struct ModuleSymbols {
+    struct Symbol {
+        uint64_t    m_address = 0;
+        uint64_t    m_size    = 0;
+        std::string m_name;
+    };
+    std::vector<Symbol> m_symbols; // sorted by address.
+    bool                m_isRelocatable = true;
+
+    void load(const std::string& path)
+    {
+        std::ifstream     is(path, std::ios::binary);
+        std::vector<char> data((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+        if (data.size() < sizeof(Elf64_Ehdr) || std::memcmp(data.data(), ELFMAG, SELFMAG) != 0)
+            return;
+        const auto* header = (const Elf64_Ehdr*) data.data();
+        m_isRelocatable    = header->e_type == ET_DYN;
+        if (header->e_shoff + header->e_shnum * sizeof(Elf64_Shdr) > data.size())
+            return;
+        const auto* sections = (const Elf64_Shdr*) (data.data() + header->e_shoff);
+        // .symtab has all functions (including ones in anonymous namespace), .dynsym is a fallback for stripped files.
+        for (uint32_t wantedType : { uint32_t(SHT_SYMTAB), uint32_t(SHT_DYNSYM) }) {
+            for (int i = 0; i < header->e_shnum; ++i) {
+                const Elf64_Shdr& section = sections[i];
+                if (section.sh_type != wantedType || section.sh_link >= header->e_shnum)
+                    continue;
+                const Elf64_Shdr& strings = sections[section.sh_link];
+                const auto*       symbols = (const Elf64_Sym*) (data.data() + section.sh_offset);
+                const size_t      count   = section.sh_size / sizeof(Elf64_Sym);
+                for (size_t j = 0; j < count; ++j) {
+                    const Elf64_Sym& sym = symbols[j];
+                    if (ELF64_ST_TYPE(sym.st_info) != STT_FUNC || !sym.st_value || sym.st_name >= strings.sh_size)
+                        continue;
+                    m_symbols.push_back({ sym.st_value, sym.st_size, demangle(data.data() + strings.sh_offset + sym.st_name) });
+                }
+            }
+            if (!m_symbols.empty())
+                break;
+        }
+        std::sort(m_symbols.begin(), m_symbols.end(), [](const Symbol& l, const Symbol& r) { return l.m_address < r.m_address; });
+    }
+
+    const Symbol* find(uint64_t address) const
+    {
+        auto it = std::upper_bound(m_symbols.begin(), m_symbols.end(), address, [](uint64_t addr, const Symbol& sym) {
+            return addr < sym.m_address;
+        });
+        if (it == m_symbols.begin())
+            return nullptr;
+        --it;
+        if (it->m_size && address >= it->m_address + it->m_size)
+            return nullptr;
+        return &*it;
+    }
+
+    static std::string demangle(const char* name)
+    {
+        int   status    = 0;
+        char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+        if (!demangled)
+            return name;
+        std::string result = demangled;
+        std::free(demangled);
+        return result;
+    }
+};
+
+struct Location {
+    std::string m_function;
+    std::string m_module;
+    uint64_t    m_offset = 0; // address in module, suitable for addr2line.
+};
+
+class Symbolizer {
+public:
+    /// Frames of caller functions hold return address, that points after the call instruction (and may be past the function end).
+    const Location& resolve(void* address, bool isReturnAddress)
+    {
+        const uint64_t pc = uint64_t(address) - (isReturnAddress ? 1 : 0);
+        auto           it = m_cache.find(pc);
+        if (it != m_cache.end())
+            return it->second;
+
+        Location location;
+        Dl_info  info{};
+        if (::dladdr((void*) pc, &info) && info.dli_fname) {
+            location.m_module           = info.dli_fname;
+            const ModuleSymbols& module = getModule(info.dli_fname);
+            location.m_offset           = module.m_isRelocatable ? pc - uint64_t(info.dli_fbase) : pc;
+            if (const auto* symbol = module.find(location.m_offset))
+                location.m_function = symbol->m_name;
+            else if (info.dli_sname)
+                location.m_function = ModuleSymbols::demangle(info.dli_sname);
+        }
+        if (location.m_function.empty()) {
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "0x%llx", (unsigned long long) (location.m_module.empty() ? pc : location.m_offset));
+            const size_t slash  = location.m_module.find_last_of('/');
+            location.m_function = location.m_module.substr(slash == std::string::npos ? 0 : slash + 1) + (location.m_module.empty() ? "" : "+") + buffer;
+        }
+        return m_cache[pc] = std::move(location);
+    }
+
+private:
+    const ModuleSymbols& getModule(const std::string& path)
+    {
+        auto it = m_modules.find(path);
+        if (it == m_modules.end()) {
+            it = m_modules.insert({ path, {} }).first;
+            // dladdr reports main executable by argv[0], which may be relative.
+            it->second.load(path.find('/') == std::string::npos ? "/proc/self/exe" : path);
+        }
+        return it->second;
+    }
+
+private:
+    std::map<std::string, ModuleSymbols> m_modules;
+    std::map<uint64_t, Location>         m_cache;
+};
+
+/// Resolve file:line using addr2line from binutils, if it is installed.
+/// Module path is passed as a separate argument without shell, so it may contain any characters.
+std::string resolveLine(const Location& location)
+{
+    char address[32];
+    std::snprintf(address, sizeof(address), "0x%llx", (unsigned long long) location.m_offset);
+    std::string modulePath = location.m_module;
+    char        program[]  = "addr2line";
+    char        option[]   = "-e";
+    char*       argv[]     = { program, option, modulePath.data(), address, nullptr };
+
+    int pipeFds[2];
+    if (::pipe(pipeFds) != 0)
+        return {};
+    posix_spawn_file_actions_t actions;
+    ::posix_spawn_file_actions_init(&actions);
+    ::posix_spawn_file_actions_addclose(&actions, pipeFds[0]);
+    ::posix_spawn_file_actions_adddup2(&actions, pipeFds[1], STDOUT_FILENO);
+    ::posix_spawn_file_actions_addclose(&actions, pipeFds[1]);
+    ::posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+    pid_t     pid     = 0;
+    const int spawned = ::posix_spawnp(&pid, program, &actions, nullptr, argv, environ);
+    ::posix_spawn_file_actions_destroy(&actions);
+    ::close(pipeFds[1]);
+
+    std::string result;
+    if (spawned == 0) {
+        char    buffer[1024];
+        ssize_t size = 0;
+        while ((size = ::read(pipeFds[0], buffer, sizeof(buffer))) > 0 || (size < 0 && errno == EINTR)) {
+            if (size > 0)
+                result.append(buffer, size);
+        }
+        int status = 0;
+        while (::waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+        }
+    }
+    ::close(pipeFds[0]);
+    result = result.substr(0, result.find('\n'));
+    while (!result.empty() && (result.back() == '\n' || result.back() == '\r'))
+        result.pop_back();
+    if (result.starts_with("??"))
+        return {};
+    return result;
+}
+
+}
+
+struct SamplingProfiler::Impl {
+    std::vector<Sample> m_samples;
+    size_t              m_droppedSamples = 0;
+    bool                m_running        = false;
+    struct sigaction    m_oldAction {};
+    mutable Symbolizer  m_symbolizer;
+};
+
+SamplingProfiler::SamplingProfiler()
+    : m_impl(std::make_unique<Impl>())
+{
+    // first backtrace() call loads libgcc, that is not safe inside a signal handler.
+    void* warmup[1];
+    ::backtrace(warmup, 1);
+
+    s_samples = new Sample[g_maxSamples];
+    s_sampleCount.store(0);
+
+    struct sigaction action {};
+    action.sa_handler = &onProfSignal;
+    action.sa_flags   = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    ::sigaction(SIGPROF, &action, &m_impl->m_oldAction);
+
+    itimerval timer{};
+    timer.it_interval.tv_usec = g_intervalUS;
+    timer.it_value.tv_usec    = g_intervalUS;
+    ::setitimer(ITIMER_PROF, &timer, nullptr);
+    m_impl->m_running = true;
+}
+
+SamplingProfiler::~SamplingProfiler()
+{
+    stop();
+}
+
+bool SamplingProfiler::isSupported()
+{
+    return true;
+}
+
+void SamplingProfiler::stop()
+{
+    if (!m_impl->m_running)
+        return;
+    itimerval timer{};
+    ::setitimer(ITIMER_PROF, &timer, nullptr);
+    ::sigaction(SIGPROF, &m_impl->m_oldAction, nullptr);
+    m_impl->m_running = false;
+
+    const size_t count = s_sampleCount.load();
+    m_impl->m_samples.assign(s_samples, s_samples + std::min(count, g_maxSamples));
+    m_impl->m_droppedSamples = count > g_maxSamples ? count - g_maxSamples : 0;
+    delete[] s_samples;
+    s_samples = nullptr;
+}
+
+void SamplingProfiler::printHotFunctions(std::ostream& os, size_t count) const
+{
+    struct Stat {
+        size_t          m_self           = 0;
+        size_t          m_total          = 0;
+        const Location* m_hottest        = nullptr; // location with most self samples.
+        size_t          m_hottestSamples = 0;
+    };
+    std::map<std::string, Stat> stats;
+    std::map<void*, size_t>     selfByAddress;
+    const size_t                total = m_impl->m_samples.size();
+    for (const Sample& sample : m_impl->m_samples) {
+        if (sample.m_depth <= g_skipFrames)
+            continue;
+        // recursive functions are counted once per sample.
+        std::set<std::string_view> seen;
+        for (int i = g_skipFrames; i < sample.m_depth; ++i) {
+            const Location& location = m_impl->m_symbolizer.resolve(sample.m_frames[i], i > g_skipFrames);
+            if (seen.insert(location.m_function).second)
+                stats[location.m_function].m_total++;
+        }
+        const Location& top     = m_impl->m_symbolizer.resolve(sample.m_frames[g_skipFrames], false);
+        Stat&           topStat = stats[top.m_function];
+        topStat.m_self++;
+        const size_t addressSamples = ++selfByAddress[sample.m_frames[g_skipFrames]];
+        if (addressSamples > topStat.m_hottestSamples) {
+            topStat.m_hottestSamples = addressSamples;
+            topStat.m_hottest        = &top;
+        }
+    }
+
+    os << "Profile: " << total << " samples (" << g_intervalUS << " us. of CPU time each)";
+    if (m_impl->m_droppedSamples)
+        os << ", " << m_impl->m_droppedSamples << " dropped";
+    os << "\n";
+    if (!total)
+        return;
+
+    std::vector<std::pair<std::string, Stat>> sorted(stats.begin(), stats.end());
+    std::sort(sorted.begin(), sorted.end(), [](const auto& l, const auto& r) {
+        return std::tie(l.second.m_self, l.second.m_total) > std::tie(r.second.m_self, r.second.m_total);
+    });
+    os << "   self%  total%  function\n";
+    for (size_t i = 0; i < std::min(count, sorted.size()); ++i) {
+        const auto& [name, stat] = sorted[i];
+        os << std::fixed << std::setprecision(1)
+           << std::setw(8) << (100.0 * stat.m_self / total)
+           << std::setw(8) << (100.0 * stat.m_total / total) << "  "
+           << (name.size() > g_maxNameLength ? name.substr(0, g_maxNameLength) + "..." : name);
+        if (stat.m_hottest) {
+            const std::string line = resolveLine(*stat.m_hottest);
+            if (!line.empty())
+                os << " (hottest at " << line << ")";
+        }
+        os << "\n";
+    }
+    os << std::defaultfloat;
+}
+
+void SamplingProfiler::writeFoldedStacks(std::ostream& os, std::string_view rootName) const
+{
+    std::map<std::string, size_t> folded;
+    for (const Sample& sample : m_impl->m_samples) {
+        if (sample.m_depth <= g_skipFrames)
+            continue;
+        std::string stack(rootName);
+        // stacks are recorded from callee to caller; everything below benchmark loop is cut by depth limit.
+        const int depth = std::min<int>(sample.m_depth, g_skipFrames + g_maxFoldedDepth);
+        for (int i = depth - 1; i >= g_skipFrames; --i) {
+            std::string name = m_impl->m_symbolizer.resolve(sample.m_frames[i], i > g_skipFrames).m_function;
+            std::replace(name.begin(), name.end(), ';', ':');
+            std::replace(name.begin(), name.end(), ' ', '_');
+            stack += ";" + name;
+        }
+        folded[stack]++;
+    }
+    for (const auto& [stack, count] : folded)
+        os << stack << " " << count << "\n";
+}
+
+#else
+
+struct SamplingProfiler::Impl {
+};
+
+SamplingProfiler::SamplingProfiler()
+    : m_impl(std::make_unique<Impl>())
+{
+}
+
+SamplingProfiler::~SamplingProfiler() = default;
+
+bool SamplingProfiler::isSupported()
+{
+    return false;
+}
+
+void SamplingProfiler::stop()
+{
+}
+
+void SamplingProfiler::printHotFunctions(std::ostream& os, size_t) const
+{
+    os << "Profiler is not supported on this platform.\n";
+}
+
+void SamplingProfiler::writeFoldedStacks(std::ostream&, std::string_view) const
+{
+}
+
+#endif
@@ -0,0 +1,34 @@
+/*
+ * Copyright (C) 2025 Smirnov Vladimir / mapron1@gmail.com
+ * SPDX-License-Identifier: CC0-1.0
+ * See LICENSE file for details.
+ */
+#pragma once
+
+#include <iosfwd>
+#include <memory>
+#include <string_view>
+
+/// Statistical CPU profiler: SIGPROF timer interrupts the process every millisecond of CPU time and records call stack.
+/// Samples are symbolized with ELF symbol table of the executable (and plugins).
+/// Only one profiler can be active at a time. Supported on Linux only.
+class SamplingProfiler {
+public:
+    SamplingProfiler();
+    ~SamplingProfiler();
+
+    static bool isSupported();
+
+    /// Stop sampling; called from destructor too.
+    void stop();
+
+    /// Print functions with most samples on top of stack (self) and in stack (total).
+    void printHotFunctions(std::ostream& os, size_t count) const;
+
+    /// Write collapsed stacks ("root;caller;callee count" lines) suitable for flamegraph.pl or speedscope.
+    void writeFoldedStacks(std::ostream& os, std::string_view rootName) const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
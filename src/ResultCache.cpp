@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2025 Smirnov Vladimir / mapron1@gmail.com
+ * SPDX-License-Identifier: CC0-1.0
+ * See LICENSE file for details.
+ */
+#include "ResultCache.h"
+#include "PluginLoader.h"
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+
+namespace {
+
+uint64_t hashFile(const std::string& path)
+{
+    std::ifstream is(path, std::ios::binary);
+    if (!is)
+        return 0;
+    uint64_t          hash = ResultCache::hashBytes({});
+    std::vector<char> buffer(1 << 20);
+    while (is) {
+        is.read(buffer.data(), buffer.size());
+        hash = ResultCache::hashBytes(std::string_view(buffer.data(), is.gcount()), hash);
+    }
+    return hash;
+}
+
+}
+
+ResultCache& ResultCache::get(const std::string& path)
+{
+    static std::map<std::string, std::unique_ptr<ResultCache>> s_caches;
+
+    auto& cache = s_caches[path];
+    if (!cache)
+        cache.reset(new ResultCache(path));
+    return *cache;
+}
+
+std::string ResultCache::getDefaultPath()
+{
+    return PluginLoader::getArtifactPath(0) + ".cache";
+}
+
+uint64_t ResultCache::hashBytes(std::string_view data, uint64_t seed)
+{
+    uint64_t hash = seed;
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+uint64_t ResultCache::hashSolution(uint64_t pluginId, std::string_view solutionId)
+{
+    static std::map<uint64_t, uint64_t> s_artifactHashes;
+
+    auto getArtifactHash = [](uint64_t id) {
+        auto it = s_artifactHashes.find(id);
+        if (it == s_artifactHashes.end())
+            it = s_artifactHashes.insert({ id, hashFile(PluginLoader::getArtifactPath(id)) }).first;
+        return it->second;
+    };
+    const uint64_t executableHash = getArtifactHash(0);
+    const uint64_t artifactHash   = getArtifactHash(pluginId);
+    uint64_t       hash           = hashBytes(std::string_view((const char*) &executableHash, sizeof(executableHash)));
+    hash                          = hashBytes(std::string_view((const char*) &artifactHash, sizeof(artifactHash)), hash);
+    return hashBytes(solutionId, hash);
+}
+
+ResultCache::ResultCache(std::string path)
+    : m_path(std::move(path))
+{
+    std::vector<std::pair<Key, Entry>> lines;
+    {
+        std::ifstream is(m_path);
+        Key           key;
+        std::string   verdict;
+        Entry         entry;
+        while (is >> std::hex >> key.m_solutionHash >> key.m_caseHash >> verdict >> std::dec >> entry.m_execTimeUS) {
+            entry.m_passed = verdict == "pass";
+            lines.push_back({ key, entry });
+        }
+    }
+    // newest lines win: walk from the end, keeping the first occurrence of each key up to the limit.
+    std::vector<std::pair<Key, Entry>> kept;
+    for (auto it = lines.rbegin(); it != lines.rend() && m_entries.size() < g_maxEntries; ++it) {
+        if (m_entries.insert(*it).second)
+            kept.push_back(*it);
+    }
+    if (kept.size() == lines.size())
+        return;
+
+    // compact: write to temporary file first, so interrupted rewrite does not lose the cache.
+    const std::string tmpPath = m_path + ".tmp";
+    {
+        std::ofstream os(tmpPath, std::ios::trunc);
+        for (auto it = kept.rbegin(); it != kept.rend(); ++it)
+            writeLine(os, it->first, it->second);
+        if (!os.flush())
+            return;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, m_path, ec);
+    if (ec)
+        std::filesystem::remove(tmpPath, ec);
+}
+
+void ResultCache::writeLine(std::ostream& os, const Key& key, const Entry& entry)
+{
+    os << std::hex << key.m_solutionHash << " " << key.m_caseHash << " "
+       << (entry.m_passed ? "pass" : "fail") << " " << std::dec << entry.m_execTimeUS << "\n";
+}
+
+const ResultCache::Entry* ResultCache::find(uint64_t solutionHash, uint64_t caseHash) const
+{
+    auto it = m_entries.find(Key{ solutionHash, caseHash });
+    return it == m_entries.end() ? nullptr : &it->second;
+}
+
+void ResultCache::store(uint64_t solutionHash, uint64_t caseHash, Entry entry)
+{
+    const Key key{ solutionHash, caseHash };
+    m_entries[key] = entry;
+    m_pending.push_back({ key, entry });
+}
+
+void ResultCache::flush()
+{
+    if (m_pending.empty())
+        return;
+    std::ofstream os(m_path, std::ios::app);
+    for (const auto& [key, entry] : m_pending)
+        writeLine(os, key, entry);
+    m_pending.clear();
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2025 Smirnov Vladimir / mapron1@gmail.com
+ * SPDX-License-Identifier: CC0-1.0
+ * See LICENSE file for details.
+ */
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/// On-disk memoization of test results.
+/// Key is pair of solution hash (code that contains solution) and test case hash (its serialized input and output).
+/// File is a text file, one "solutionHash caseHash verdict execTimeUS" line per result; new results are appended.
+/// File is rewritten on load when it contains duplicate keys or more than g_maxEntries results (oldest are dropped).
+class ResultCache {
+public:
+    struct Entry {
+        bool    m_passed     = false;
+        int64_t m_execTimeUS = 0;
+    };
+
+    /// Cache for file, loaded on first call.
+    static ResultCache& get(const std::string& path);
+
+    /// Default cache file is placed near the executable.
+    static std::string getDefaultPath();
+
+    /// FNV-1a 64 hash.
+    static uint64_t hashBytes(std::string_view data, uint64_t seed = 0xcbf29ce484222325ULL);
+
+    /// Stream buffer that hashes everything written to it with hashBytes(), so values can be hashed without serializing them to memory.
+    class HashStreamBuf : public std::streambuf {
+    public:
+        HashStreamBuf() { setp(m_buffer, m_buffer + sizeof(m_buffer)); }
+
+        /// Hash of all bytes written so far.
+        uint64_t getHash()
+        {
+            sync();
+            return m_hash;
+        }
+
+    protected:
+        int_type overflow(int_type ch) override
+        {
+            sync();
+            if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+                const char c = traits_type::to_char_type(ch);
+                m_hash       = hashBytes(std::string_view(&c, 1), m_hash);
+            }
+            return traits_type::not_eof(ch);
+        }
+        int sync() override
+        {
+            m_hash = hashBytes(std::string_view(pbase(), pptr() - pbase()), m_hash);
+            setp(m_buffer, m_buffer + sizeof(m_buffer));
+            return 0;
+        }
+
+    private:
+        char     m_buffer[4096];
+        uint64_t m_hash = 0xcbf29ce484222325ULL;
+    };
+
+    /// Hash of binary that contains solution (and of the checker executable, as it contains code tests).
+    static uint64_t hashSolution(uint64_t pluginId, std::string_view solutionId);
+
+    const Entry* find(uint64_t solutionHash, uint64_t caseHash) const;
+
+    void store(uint64_t solutionHash, uint64_t caseHash, Entry entry);
+
+    /// Append results stored since last flush to the file.
+    void flush();
+
+private:
+    static constexpr size_t g_maxEntries = 1 << 18;
+
+    explicit ResultCache(std::string path);
+
+    struct Key {
+        uint64_t m_solutionHash = 0;
+        uint64_t m_caseHash     = 0;
+
+        bool operator==(const Key&) const = default;
+    };
+    struct KeyHash {
+        size_t operator()(const Key& key) const { return size_t(key.m_solutionHash ^ (key.m_caseHash * 0x9E3779B97F4A7C15ULL)); }
+    };
+
+    static void writeLine(std::ostream& os, const Key& key, const Entry& entry);
+
+private:
+    std::string                             m_path;
+    std::unordered_map<Key, Entry, KeyHash> m_entries;
+    std::vector<std::pair<Key, Entry>>      m_pending;
+};
@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2025 Smirnov Vladimir / mapron1@gmail.com
+ * SPDX-License-Identifier: CC0-1.0
+ * See LICENSE file for details.
+ */
+#include "Server.h"
+#include "CommonTestUtils.h"
+#include "PluginLoader.h"
+#include "SocketUtils.h"
+
+#include <iostream>
+#include <sstream>
+
+#ifndef _WIN32
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#endif
+
+namespace Server {
+
+bool executeRequest(const std::vector<std::string>& args, std::ostream& response, std::set<std::string>* passedSolutions)
+{
+    CLIParams requestParams;
+    if (!requestParams.parseArgs(response, args))
+        return false;
+    if (!requestParams.m_pluginPaths.empty()) {
+        response << "Plugins are loaded only by server, use '--plugins' when starting it.\n";
+        return false;
+    }
+    if (!requestParams.m_testInputFile.empty() || !requestParams.m_testOutputFile.empty()) {
+        response << "Custom test files are not supported in server mode.\n";
+        return false;
+    }
+    if (requestParams.m_task == CLIParams::Task::Serve || !requestParams.m_socketPath.empty()) {
+        response << "Server can not handle '--task Serve' or '--socket' requests.\n";
+        return false;
+    }
+    try {
+        requestParams.createStreams();
+        // everything that would go to the console is sent to client instead.
+        if (requestParams.m_loggingStream == &std::cout)
+            requestParams.m_loggingStream = &response;
+        if (requestParams.m_printStream == &std::cout)
+            requestParams.m_printStream = &response;
+        if (requestParams.m_incremental)
+            requestParams.m_passedSolutions = passedSolutions;
+
+        const bool result = AbstractProblemData::runAll(requestParams);
+        // server process trace, including startup and previous requests.
+        if (!requestParams.m_traceFile.empty())
+            Tracing::writeTo(requestParams.m_traceFile, *requestParams.m_loggingStream);
+        return result;
+    }
+    catch (std::exception& ex) {
+        response << "std::exception was thrown:" << ex.what() << "\n";
+        return false;
+    }
+}
+
+}
+
+#ifndef _WIN32
+namespace {
+constexpr const char* g_listenFdEnv = "CONTEST_CHECKER_SERVER_FD";
+
+struct FileStamp {
+    int64_t m_mtime = 0;
+    int64_t m_size  = 0;
+
+    bool operator==(const FileStamp&) const = default;
+};
+
+FileStamp getFileStamp(const std::string& path)
+{
+    struct stat st{};
+    if (::stat(path.c_str(), &st) != 0)
+        return {};
+    return { int64_t(st.st_mtime), int64_t(st.st_size) };
+}
+
+/// Response is one status byte ('0' - success) followed by log text.
+std::string handleRequest(const std::vector<std::string>& args, const CLIParams& serverParams, std::set<std::string>& passedSolutions)
+{
+    std::ostringstream response;
+    // only changed plugins are reloaded, and their solutions will be re-checked as they get new id.
+    const bool pluginsLoaded = PluginLoader::refresh(serverParams.m_pluginPaths, response);
+    const bool success       = Server::executeRequest(args, response, &passedSolutions) && pluginsLoaded;
+    return (success ? "0" : "1") + response.str();
+}
+
+}
+
+namespace Server {
+
+bool serve(const CLIParams& params, int, char** argv)
+{
+    std::ostream& logger = *params.m_loggingStream;
+    if (params.m_socketPath.empty()) {
+        logger << "Server mode requires '--socket' parameter.\n";
+        return false;
+    }
+
+    // sends use MSG_NOSIGNAL where it exists; elsewhere client that disconnects early must not kill server either.
+    std::signal(SIGPIPE, SIG_IGN);
+
+    int listenFd = -1;
+    if (const char* inheritedFd = std::getenv(g_listenFdEnv)) {
+        listenFd = std::atoi(inheritedFd);
+        ::unsetenv(g_listenFdEnv);
+        logger << "Server restarted after rebuild, socket: " << params.m_socketPath << "\n";
+    } else {
+        std::string error;
+        listenFd = SocketUtils::listenUnix(params.m_socketPath, error);
+        if (listenFd < 0) {
+            logger << "Server failed to start: " << error << "\n";
+            return false;
+        }
+        logger << "Server is listening on " << params.m_socketPath << "\n";
+    }
+    logger << std::flush;
+
+    const std::string     executablePath  = PluginLoader::getArtifactPath(0);
+    const FileStamp       executableStamp = getFileStamp(executablePath);
+    std::set<std::string> passedSolutions;
+
+    while (true) {
+        pollfd pfd{ .fd = listenFd, .events = POLLIN, .revents = 0 };
+        if (::poll(&pfd, 1, -1) < 0) {
+            if (errno == EINTR)
+                continue;
+            logger << "poll() failed: " << std::strerror(errno) << "\n";
+            return false;
+        }
+        // pending connection stays in the listen queue, so new process image will accept it.
+        if (!executablePath.empty() && getFileStamp(executablePath) != executableStamp) {
+            logger << "Executable changed, restarting...\n"
+                   << std::flush;
+            ::setenv(g_listenFdEnv, std::to_string(listenFd).c_str(), 1);
+            ::execv(executablePath.c_str(), argv);
+            logger << "execv() failed: " << std::strerror(errno) << ", continue with old executable.\n";
+            ::unsetenv(g_listenFdEnv);
+        }
+
+        const int clientFd = SocketUtils::acceptConnection(listenFd);
+        if (clientFd < 0)
+            continue;
+
+        std::vector<std::string> args;
+        SocketUtils::readArgs(clientFd, args);
+        logger << "Request:";
+        for (const auto& arg : args)
+            logger << " " << arg;
+        logger << "\n"
+               << std::flush;
+
+        PerformanceCounter requestCounter(Perf::ExecTime);
+        const std::string  response = handleRequest(args, params, passedSolutions);
+        SocketUtils::writeAll(clientFd, response);
+        SocketUtils::closeSocket(clientFd);
+
+        logger << "Request " << (response[0] == '0' ? "succeeded" : "failed");
+        requestCounter.printTo(logger, true);
+    }
+    return true;
+}
+
+bool sendRequest(const CLIParams& params, int argc, char** argv)
+{
+    std::string error;
+    const int   fd = SocketUtils::connectUnix(params.m_socketPath, error);
+    if (fd < 0) {
+        std::cerr << "Failed to reach server: " << error << "\n";
+        return false;
+    }
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string_view(argv[i]) == "--socket") {
+            ++i;
+            continue;
+        }
+        args.push_back(argv[i]);
+    }
+    SocketUtils::writeAll(fd, SocketUtils::encodeArgs(args));
+    const std::string response = SocketUtils::readAll(fd);
+    SocketUtils::closeSocket(fd);
+    if (response.empty()) {
+        std::cerr << "Server closed connection without response.\n";
+        return false;
+    }
+    std::cout << std::string_view(response).substr(1) << std::flush;
+    return response[0] == '0';
+}
+
+}
+
+#else
+
+namespace Server {
+
+bool serve(const CLIParams& params, int, char**)
+{
+    *params.m_loggingStream << "Server mode is not supported on this platform.\n";
+    return false;
+}
+
+bool sendRequest(const CLIParams&, int, char**)
+{
+    std::cerr << "Server mode is not supported on this platform.\n";
+    return false;
+}
+
+}
+
+#endif
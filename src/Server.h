@@ -0,0 +1,28 @@
+/*
+ * Copyright (C) 2025 Smirnov Vladimir / mapron1@gmail.com
+ * SPDX-License-Identifier: CC0-1.0
+ * See LICENSE file for details.
+ */
+#pragma once
+
+#include "CommandLine.h"
+
+#include <iosfwd>
+
+/// Persistent checker mode: one long-running process keeps all test sets in memory
+/// and executes run requests received over a local Unix socket.
+namespace Server {
+
+/// Run server loop listening on params.m_socketPath. Returns only on fatal error.
+/// If executable file is rebuilt, server re-executes itself keeping listening socket open.
+bool serve(const CLIParams& params, int argc, char** argv);
+
+/// Forward command line (without --socket) to the server and print its response to stdout.
+/// Returns false if server reported failure or is not reachable.
+bool sendRequest(const CLIParams& params, int argc, char** argv);
+
+/// Parse command line of a request and run it, logging and printing into response instead of console.
+/// passedSolutions is used for incremental checks and may be null.
+bool executeRequest(const std::vector<std::string>& args, std::ostream& response, std::set<std::string>* passedSolutions);
+
+}
@@ -0,0 +1,314 @@
+/*
+ * Copyright (C) 2025 Smirnov Vladimir / mapron1@gmail.com
+ * SPDX-License-Identifier: CC0-1.0
+ * See LICENSE file for details.
+ */
+#include "SocketUtils.h"
+
+#ifndef _WIN32
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#endif
+
+#ifndef _WIN32
+namespace {
+
+#ifdef MSG_NOSIGNAL
+constexpr int g_sendFlags = MSG_NOSIGNAL; // closed peer should not kill the process with SIGPIPE.
+#else
+constexpr int g_sendFlags = 0;
+#endif
+
+bool fillAddress(const std::string& path, sockaddr_un& addr, std::string& error)
+{
+    addr            = {};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        error = "socket path '" + path + "' is too long";
+        return false;
+    }
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+bool splitAddress(const std::string& address, std::string& host, std::string& port, std::string& error)
+{
+    const auto colon = address.rfind(':');
+    if (colon == std::string::npos) {
+        error = "address '" + address + "' must be in 'host:port' format";
+        return false;
+    }
+    host = address.substr(0, colon);
+    port = address.substr(colon + 1);
+    return true;
+}
+
+int failWithErrno(int fd, const std::string& what, std::string& error)
+{
+    error = what + ": " + std::strerror(errno);
+    if (fd >= 0)
+        ::close(fd);
+    return -1;
+}
+
+}
+
+namespace SocketUtils {
+
+int listenUnix(const std::string& path, std::string& error)
+{
+    sockaddr_un addr;
+    if (!fillAddress(path, addr, error))
+        return -1;
+    // socket file left by previous server is removed, but not a regular file the path was mistyped to.
+    struct stat st{};
+    if (::lstat(path.c_str(), &st) == 0) {
+        if (!S_ISSOCK(st.st_mode)) {
+            error = "'" + path + "' already exists and is not a socket";
+            return -1;
+        }
+        ::unlink(path.c_str());
+    }
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || ::bind(fd, (const sockaddr*) &addr, sizeof(addr)) != 0 || ::listen(fd, 16) != 0)
+        return failWithErrno(fd, "failed to listen on '" + path + "'", error);
+    return fd;
+}
+
+int connectUnix(const std::string& path, std::string& error)
+{
+    sockaddr_un addr;
+    if (!fillAddress(path, addr, error))
+        return -1;
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || ::connect(fd, (const sockaddr*) &addr, sizeof(addr)) != 0)
+        return failWithErrno(fd, "failed to connect to '" + path + "'", error);
+    return fd;
+}
+
+int listenTcp(const std::string& address, int& boundPort, std::string& error)
+{
+    std::string host, port;
+    if (!splitAddress(address, host, port, error))
+        return -1;
+    addrinfo hints{};
+    hints.ai_flags    = AI_PASSIVE;
+    hints.ai_family   = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+
+    addrinfo* info = nullptr;
+    if (const int rc = ::getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(), &hints, &info); rc != 0) {
+        error = "failed to resolve '" + address + "': " + ::gai_strerror(rc);
+        return -1;
+    }
+    const int fd    = ::socket(info->ai_family, info->ai_socktype, info->ai_protocol);
+    int       reuse = 1;
+    if (fd >= 0)
+        ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    const bool ok = fd >= 0 && ::bind(fd, info->ai_addr, info->ai_addrlen) == 0 && ::listen(fd, 64) == 0;
+    ::freeaddrinfo(info);
+    if (!ok)
+        return failWithErrno(fd, "failed to listen on '" + address + "'", error);
+
+    sockaddr_in bound{};
+    socklen_t   boundSize = sizeof(bound);
+    ::getsockname(fd, (sockaddr*) &bound, &boundSize);
+    boundPort = ntohs(bound.sin_port);
+    return fd;
+}
+
+int connectTcp(const std::string& address, std::string& error)
+{
+    std::string host, port;
+    if (!splitAddress(address, host, port, error))
+        return -1;
+    addrinfo hints{};
+    hints.ai_family   = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    addrinfo* info = nullptr;
+    if (const int rc = ::getaddrinfo(host.c_str(), port.c_str(), &hints, &info); rc != 0) {
+        error = "failed to resolve '" + address + "': " + ::gai_strerror(rc);
+        return -1;
+    }
+    int fd = -1;
+    for (addrinfo* it = info; it; it = it->ai_next) {
+        fd = ::socket(it->ai_family, it->ai_socktype, it->ai_protocol);
+        if (fd >= 0 && ::connect(fd, it->ai_addr, it->ai_addrlen) == 0)
+            break;
+        if (fd >= 0)
+            ::close(fd);
+        fd = -1;
+    }
+    ::freeaddrinfo(info);
+    if (fd < 0)
+        return failWithErrno(fd, "failed to connect to '" + address + "'", error);
+    return fd;
+}
+
+int acceptConnection(int listenFd)
+{
+    return ::accept(listenFd, nullptr, nullptr);
+}
+
+void closeSocket(int fd)
+{
+    ::close(fd);
+}
+
+bool writeAll(int fd, std::string_view data)
+{
+    while (!data.empty()) {
+        const auto written = ::send(fd, data.data(), data.size(), g_sendFlags);
+        if (written <= 0)
+            return false;
+        data.remove_prefix(written);
+    }
+    return true;
+}
+
+std::string readAll(int fd)
+{
+    std::string result;
+    char        buffer[4096];
+    while (true) {
+        const auto size = ::read(fd, buffer, sizeof(buffer));
+        if (size <= 0)
+            break;
+        result.append(buffer, size);
+    }
+    return result;
+}
+
+bool readLine(int fd, std::string& line)
+{
+    line.clear();
+    char c = 0;
+    while (::read(fd, &c, 1) == 1) {
+        if (c == '\n')
+            return true;
+        line += c;
+    }
+    return false;
+}
+
+bool readExact(int fd, std::string& data, size_t size)
+{
+    data.resize(size);
+    size_t offset = 0;
+    while (offset < size) {
+        const auto received = ::read(fd, data.data() + offset, size - offset);
+        if (received <= 0)
+            return false;
+        offset += received;
+    }
+    return true;
+}
+
+bool readAvailable(int fd, std::string& buffer)
+{
+    char chunk[4096];
+    while (true) {
+        const auto received = ::recv(fd, chunk, sizeof(chunk), MSG_DONTWAIT);
+        if (received > 0) {
+            buffer.append(chunk, received);
+            continue;
+        }
+        if (received < 0 && errno == EINTR)
+            continue;
+        return received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+    }
+}
+
+bool readArgs(int fd, std::vector<std::string>& args)
+{
+    args.clear();
+    std::string line;
+    while (readLine(fd, line)) {
+        if (line.empty())
+            return true;
+        args.push_back(line);
+    }
+    return false;
+}
+
+}
+
+#else
+
+namespace SocketUtils {
+
+int listenUnix(const std::string&, std::string& error)
+{
+    error = "sockets are not supported on this platform";
+    return -1;
+}
+int connectUnix(const std::string&, std::string& error)
+{
+    error = "sockets are not supported on this platform";
+    return -1;
+}
+int listenTcp(const std::string&, int&, std::string& error)
+{
+    error = "sockets are not supported on this platform";
+    return -1;
+}
+int connectTcp(const std::string&, std::string& error)
+{
+    error = "sockets are not supported on this platform";
+    return -1;
+}
+int acceptConnection(int)
+{
+    return -1;
+}
+void closeSocket(int)
+{
+}
+bool writeAll(int, std::string_view)
+{
+    return false;
+}
+std::string readAll(int)
+{
+    return {};
+}
+bool readLine(int, std::string&)
+{
+    return false;
+}
+bool readExact(int, std::string&, size_t)
+{
+    return false;
+}
+bool readAvailable(int, std::string&)
+{
+    return false;
+}
+bool readArgs(int, std::vector<std::string>&)
+{
+    return false;
+}
+
+}
+
+#endif
+
+namespace SocketUtils {
+
+std::string encodeArgs(const std::vector<std::string>& args)
+{
+    std::string result;
+    for (const std::string& arg : args)
+        result += arg + '\n';
+    return result + '\n';
+}
+
+}
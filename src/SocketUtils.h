@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2025 Smirnov Vladimir / mapron1@gmail.com
+ * SPDX-License-Identifier: CC0-1.0
+ * See LICENSE file for details.
+ */
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// Minimal blocking socket helpers for server, coordinator and workers. Sockets are plain file descriptors.
+/// Only POSIX systems are supported; on other platforms every open function fails.
+namespace SocketUtils {
+
+/// Listen on local Unix socket, removing stale socket file first. Returns -1 and fills error on failure.
+int listenUnix(const std::string& path, std::string& error);
+int connectUnix(const std::string& path, std::string& error);
+
+/// Address is "host:port"; port 0 selects any free port, actual port is stored in boundPort.
+int listenTcp(const std::string& address, int& boundPort, std::string& error);
+int connectTcp(const std::string& address, std::string& error);
+
+int  acceptConnection(int listenFd);
+void closeSocket(int fd);
+
+bool        writeAll(int fd, std::string_view data);
+std::string readAll(int fd);
+
+/// Read until '\n' (not included in line). Returns false on closed connection.
+bool readLine(int fd, std::string& line);
+bool readExact(int fd, std::string& data, size_t size);
+
+/// Append everything that can be read without blocking. Returns false on closed connection or error.
+bool readAvailable(int fd, std::string& buffer);
+
+/// Command line arguments, each terminated by '\n'; empty line ends the list.
+std::string encodeArgs(const std::vector<std::string>& args);
+bool        readArgs(int fd, std::vector<std::string>& args);
+
+}
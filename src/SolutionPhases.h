@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2025 Smirnov Vladimir / mapron1@gmail.com
+ * SPDX-License-Identifier: CC0-1.0
+ * See LICENSE file for details.
+ */
+#pragma once
+
+/// Named phases inside solution code:
+///     CC_PHASE("sort");
+///     std::sort(values.begin(), values.end());
+/// Phase lasts until the end of enclosing scope. Time, allocations and calls of every phase are aggregated
+/// per test case and printed with '--print-all-cases 1'.
+/// Without ENABLE_SOLUTION_PHASES CMake option macro expands to nothing, so solutions may keep it.
+
+#ifdef CONTEST_CHECKER_SOLUTION_PHASES
+
+#include "CustomAlloc.h"
+#include "Tracing.h"
+
+#include <cstring>
+#include <iomanip>
+#include <ostream>
+
+namespace SolutionPhases {
+
+/// Statistics of one CC_PHASE() line, stored in thread_local variable next to it.
+/// Recording is a few additions, without lock, lookup or allocation.
+struct Stat {
+    const char*       m_name       = nullptr;
+    uint64_t          m_generation = 0; // stat is listed and valid only while it equals t_generation.
+    uint64_t          m_calls      = 0;
+    int64_t           m_timeNs     = 0;
+    CustomAlloc::Info m_newInfo    = {};
+    Stat*             m_next       = nullptr;
+};
+
+/// Stats used by current thread since last reset(), in order of first use.
+inline thread_local Stat*    t_first      = nullptr;
+inline thread_local Stat*    t_last       = nullptr;
+inline thread_local uint64_t t_generation = 1;
+
+/// Clear statistics of current thread, called before each test case.
+/// Stats are not touched, as they may belong to unloaded plugin; they are cleared on next use instead.
+inline void reset()
+{
+    t_first = t_last = nullptr;
+    t_generation++;
+}
+
+/// Print statistics of current thread since last reset(), one line per phase name.
+inline void printTo(std::ostream& os)
+{
+    for (const Stat* stat = t_first; stat; stat = stat->m_next) {
+        // the same name may be used on several lines, they are printed together.
+        bool printed = false;
+        for (const Stat* prev = t_first; prev != stat && !printed; prev = prev->m_next)
+            printed = std::strcmp(prev->m_name, stat->m_name) == 0;
+        if (printed)
+            continue;
+        Stat total = *stat;
+        for (const Stat* next = stat->m_next; next; next = next->m_next) {
+            if (std::strcmp(next->m_name, stat->m_name) != 0)
+                continue;
+            total.m_calls += next->m_calls;
+            total.m_timeNs += next->m_timeNs;
+            total.m_newInfo.m_calls += next->m_newInfo.m_calls;
+            total.m_newInfo.m_totalBytes += next->m_newInfo.m_totalBytes;
+        }
+        os << "  phase '" << total.m_name << "': calls: " << total.m_calls
+           << ", time: " << std::fixed << std::setprecision(3) << total.m_timeNs / 1000.0 << std::defaultfloat << " us.";
+        if (total.m_newInfo.m_calls)
+            os << ", new calls: " << total.m_newInfo.m_calls << " (" << total.m_newInfo.m_totalBytes << " bytes)";
+        os << "\n";
+    }
+}
+
+class Scope {
+public:
+    Scope(Stat& stat, const char* name)
+        : m_stat(stat)
+        , m_newInfo(CustomAlloc::getNewInfo())
+        , m_startNs(PerformanceCounterDetails::getCurrentNanoseconds())
+    {
+        if (m_stat.m_generation == t_generation)
+            return;
+        m_stat = Stat{ .m_name = name, .m_generation = t_generation };
+        (t_last ? t_last->m_next : t_first) = &m_stat;
+        t_last                              = &m_stat;
+    }
+    ~Scope()
+    {
+        const int64_t           durationNs = PerformanceCounterDetails::getCurrentNanoseconds() - m_startNs;
+        const CustomAlloc::Info newInfo    = CustomAlloc::getNewInfo() - m_newInfo;
+        m_stat.m_calls++;
+        m_stat.m_timeNs += durationNs;
+        m_stat.m_newInfo.m_calls += newInfo.m_calls;
+        m_stat.m_newInfo.m_totalBytes += newInfo.m_totalBytes;
+        m_stat.m_newInfo.m_timeSpentNanosec += newInfo.m_timeSpentNanosec;
+
+        Tracing::Event event;
+        std::strncpy(event.m_name, m_stat.m_name, sizeof(event.m_name) - 1);
+        event.m_category   = "solution phase";
+        event.m_startNs    = m_startNs;
+        event.m_durationNs = durationNs;
+        event.m_newInfo    = newInfo;
+        Tracing::record(event);
+    }
+    Scope(const Scope&)            = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    Stat&             m_stat;
+    CustomAlloc::Info m_newInfo;
+    int64_t           m_startNs;
+};
+
+}
+
+#define CC_PHASE_CONCAT_IMPL(a, b) a##b
+#define CC_PHASE_CONCAT(a, b) CC_PHASE_CONCAT_IMPL(a, b)
+#define CC_PHASE(name)                                                          \
+    thread_local SolutionPhases::Stat CC_PHASE_CONCAT(ccPhaseStat, __LINE__);   \
+    const SolutionPhases::Scope       CC_PHASE_CONCAT(ccPhaseScope, __LINE__)(CC_PHASE_CONCAT(ccPhaseStat, __LINE__), name)
+
+#else
+
+#define CC_PHASE(name) static_cast<void>(0)
+
+#endif
@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2025 Smirnov Vladimir / mapron1@gmail.com
+ * SPDX-License-Identifier: CC0-1.0
+ * See LICENSE file for details.
+ */
+#include "StreamingCompare.h"
+
+#include "TestFiles.h"
+
+#include <cctype>
+#include <ostream>
+
+namespace StreamingCompare {
+namespace {
+
+uint64_t s_hashThreshold = 64ULL << 20;
+
+bool isSeparator(char c)
+{
+    return std::isspace(static_cast<unsigned char>(c));
+}
+
+/// Reads expected file token by token, tracking line number.
+class TokenReader {
+public:
+    explicit TokenReader(const std::string& path)
+        : m_file(TestFiles::open(path))
+        , m_buf(m_file->rdbuf())
+    {
+    }
+
+    /// Returns false at end of file.
+    bool next(std::string& token)
+    {
+        token.clear();
+        int c = m_buf->sgetc();
+        while (c != EOF && isSeparator(static_cast<char>(c))) {
+            if (c == '\n')
+                m_line++;
+            c = m_buf->snextc();
+        }
+        m_tokenLine = m_line;
+        while (c != EOF && !isSeparator(static_cast<char>(c))) {
+            token += static_cast<char>(c);
+            c = m_buf->snextc();
+        }
+        return !token.empty();
+    }
+
+    uint64_t getTokenLine() const { return m_tokenLine; }
+
+private:
+    std::unique_ptr<std::istream> m_file;
+    std::streambuf*               m_buf;
+    uint64_t                      m_line      = 1;
+    uint64_t                      m_tokenLine = 1;
+};
+
+/// Splits written text into tokens and compares each with the next token of expected file.
+/// After first difference all writes fail, so the rest of writeTo() is cheap.
+class ComparingStreamBuf : public std::streambuf {
+public:
+    explicit ComparingStreamBuf(const std::string& expectedPath)
+        : m_reader(expectedPath)
+    {
+    }
+
+    std::optional<Mismatch> finish()
+    {
+        if (!m_mismatch && !m_token.empty())
+            compareToken();
+        if (!m_mismatch && m_reader.next(m_expected))
+            m_mismatch = Mismatch{ m_tokenIndex, m_reader.getTokenLine(), m_expected, {} };
+        return m_mismatch;
+    }
+
+protected:
+    int_type overflow(int_type c) override
+    {
+        if (traits_type::eq_int_type(c, traits_type::eof()))
+            return traits_type::not_eof(c);
+        return put(traits_type::to_char_type(c)) ? c : traits_type::eof();
+    }
+
+    std::streamsize xsputn(const char* s, std::streamsize count) override
+    {
+        for (std::streamsize i = 0; i < count; ++i) {
+            if (!put(s[i]))
+                return i;
+        }
+        return count;
+    }
+
+private:
+    bool put(char c)
+    {
+        if (m_mismatch)
+            return false;
+        if (!isSeparator(c)) {
+            m_token += c;
+            return true;
+        }
+        if (!m_token.empty())
+            compareToken();
+        return !m_mismatch;
+    }
+
+    void compareToken()
+    {
+        if (!m_reader.next(m_expected) || m_expected != m_token)
+            m_mismatch = Mismatch{ m_tokenIndex, m_reader.getTokenLine(), m_expected, m_token };
+        m_tokenIndex++;
+        m_token.clear();
+    }
+
+private:
+    TokenReader             m_reader;
+    std::string             m_token;
+    std::string             m_expected;
+    uint64_t                m_tokenIndex = 0;
+    std::optional<Mismatch> m_mismatch;
+};
+
+}
+
+void setHashThreshold(uint64_t bytes)
+{
+    s_hashThreshold = bytes;
+}
+
+uint64_t getHashThreshold()
+{
+    return s_hashThreshold;
+}
+
+bool isHashedSize(const std::string& path)
+{
+    return TestFiles::getContentSize(path) >= s_hashThreshold;
+}
+
+Digest DigestStreamBuf::finish()
+{
+    if (m_inToken)
+        put(' ');
+    return { m_hash, m_tokens };
+}
+
+DigestStreamBuf::int_type DigestStreamBuf::overflow(int_type c)
+{
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+        put(traits_type::to_char_type(c));
+    return traits_type::not_eof(c);
+}
+
+std::streamsize DigestStreamBuf::xsputn(const char* s, std::streamsize count)
+{
+    for (std::streamsize i = 0; i < count; ++i)
+        put(s[i]);
+    return count;
+}
+
+void DigestStreamBuf::put(char c)
+{
+    constexpr uint64_t prime = 0x100000001b3ULL;
+    if (isSeparator(c)) {
+        if (!m_inToken)
+            return;
+        m_inToken = false;
+        m_tokens++;
+        c = ' ';
+    } else {
+        m_inToken = true;
+    }
+    m_hash = (m_hash ^ static_cast<unsigned char>(c)) * prime;
+}
+
+std::optional<Mismatch> findFirstMismatch(const std::string& expectedPath, const std::function<void(std::ostream&)>& writer)
+{
+    ComparingStreamBuf buf(expectedPath);
+    std::ostream       os(&buf);
+    writer(os);
+    return buf.finish();
+}
+
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2025 Smirnov Vladimir / mapron1@gmail.com
+ * SPDX-License-Identifier: CC0-1.0
+ * See LICENSE file for details.
+ */
+#pragma once
+
+#include "TestFiles.h"
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+/// Verification of huge outputs without keeping expected value in memory.
+/// Expected output file is parsed and written back, and only digest of its tokens is kept; calculated output is written through
+/// DigestStreamBuf and compared by digest. So both sides are in canonical writeTo() form and verdict is the same as with
+/// in-memory comparison of parsed values. Tokens are separated by any whitespace.
+namespace StreamingCompare {
+
+/// Output files of this size and bigger are loaded as digest instead of parsed value. Must be set before tests are loaded.
+void     setHashThreshold(uint64_t bytes);
+uint64_t getHashThreshold();
+
+struct Digest {
+    uint64_t m_hash   = 0;
+    uint64_t m_tokens = 0;
+
+    bool operator==(const Digest&) const = default;
+};
+
+/// Expected output of one test case; when m_path is empty, case uses its parsed m_output as usual.
+struct ExpectedOutput {
+    std::string m_path;
+    Digest      m_digest;
+
+    bool isHashed() const { return !m_path.empty(); }
+};
+
+/// Whether expected output file is big enough to be kept as digest (decompressed size is compared with hash threshold).
+bool isHashedSize(const std::string& path);
+
+/// FNV-1a 64 (same as ResultCache::hashBytes) of tokens, each token is followed by single space.
+class DigestStreamBuf : public std::streambuf {
+public:
+    Digest finish();
+
+protected:
+    int_type        overflow(int_type c) override;
+    std::streamsize xsputn(const char* s, std::streamsize count) override;
+
+private:
+    void put(char c);
+
+private:
+    uint64_t m_hash    = 0xcbf29ce484222325ULL;
+    uint64_t m_tokens  = 0;
+    bool     m_inToken = false;
+};
+
+template<class T>
+Digest digestOf(const T& value)
+{
+    DigestStreamBuf buf;
+    std::ostream    os(&buf);
+    value.writeTo(os);
+    return buf.finish();
+}
+
+/// Returns digest of expected value if file is not less than hash threshold, otherwise empty ExpectedOutput.
+/// Value is parsed with T::readFrom() and digested from T::writeTo(), e.g. "007" and "7" give the same digest for integer.
+template<class T>
+ExpectedOutput loadExpected(const std::string& path)
+{
+    if (!isHashedSize(path))
+        return {};
+    T value{};
+    value.readFrom(*TestFiles::open(path));
+    return { path, digestOf(value) };
+}
+
+struct Mismatch {
+    uint64_t    m_tokenIndex = 0;
+    uint64_t    m_line       = 0; // 1-based line in expected file.
+    std::string m_expected;       // empty if expected output ended earlier.
+    std::string m_calculated;     // empty if calculated output ended earlier.
+};
+
+/// Finds first differing token between expected file and output produced by writer, reading both as streams.
+/// Returns nullopt if outputs are the same.
+std::optional<Mismatch> findFirstMismatch(const std::string& expectedPath, const std::function<void(std::ostream&)>& writer);
+
+}
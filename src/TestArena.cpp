@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2025 Smirnov Vladimir / mapron1@gmail.com
+ * SPDX-License-Identifier: CC0-1.0
+ * See LICENSE file for details.
+ */
+#include "TestArena.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#else
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+namespace TestArena {
+namespace {
+
+constexpr size_t g_blockSize      = 64 << 20;
+constexpr size_t g_maxReserve     = sizeof(void*) == 8 ? size_t(16) << 30 : size_t(512) << 20;
+constexpr size_t g_cacheLine      = 64;
+constexpr size_t g_smallAlignment = 16;
+constexpr size_t g_pageSize       = 4096; // smallest page size; touching more often than needed is harmless.
+
+// Arena is one reserved address range, committed by blocks from its begin, so owns() is two compares.
+Options            s_options;
+thread_local bool  t_active = false;
+std::mutex         s_mutex;
+std::atomic<char*> s_rangeBegin{ nullptr }; // set once, end is published after begin.
+std::atomic<char*> s_rangeEnd{ nullptr };
+size_t             s_committed = 0; // from range begin.
+size_t             s_offset    = 0; // used bytes from range begin.
+Stats              s_stats;
+
+/// Reserves address space without memory; tries smaller sizes if address space is limited (ulimit -v).
+char* reserveRange(size_t& size)
+{
+    for (size = g_maxReserve; size >= g_blockSize; size /= 2) {
+#ifndef _WIN32
+        void* memory = ::mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (memory != MAP_FAILED)
+            return static_cast<char*>(memory);
+#else
+        if (void* memory = ::VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS))
+            return static_cast<char*>(memory);
+#endif
+    }
+    return nullptr;
+}
+
+bool commitBlock(char* begin, size_t size)
+{
+#ifndef _WIN32
+    if (::mprotect(begin, size, PROT_READ | PROT_WRITE) != 0)
+        return false;
+#ifdef MADV_HUGEPAGE
+    if (s_options.m_hugePages)
+        ::madvise(begin, size, MADV_HUGEPAGE);
+#endif
+    return true;
+#else
+    return ::VirtualAlloc(begin, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+#endif
+}
+
+/// Reads and writes back one byte per page, which maps it even if it was never written or was swapped out.
+void prefault(char* begin, size_t size)
+{
+    volatile char* data = begin;
+    for (size_t offset = 0; offset < size; offset += g_pageSize)
+        data[offset] = data[offset];
+}
+
+}
+
+void configure(const Options& options)
+{
+    s_options = options;
+}
+
+const Options& getOptions()
+{
+    return s_options;
+}
+
+bool prepareLoaded()
+{
+    std::lock_guard lock(s_mutex);
+    char*           begin  = s_rangeBegin.load(std::memory_order_relaxed);
+    bool            result = true;
+    if (!begin || !s_offset)
+        return result;
+#ifndef _WIN32
+    // madvise and mlock need page aligned address; range is mapped, so its begin is aligned.
+    if (s_options.m_willNeed)
+        ::madvise(begin, s_offset, MADV_WILLNEED);
+    if (s_options.m_lock && ::mlock(begin, s_offset) != 0)
+        result = false;
+#endif
+    if (s_options.m_prefault)
+        prefault(begin, s_offset);
+    return result;
+}
+
+Scope::Scope()
+    : m_previous(t_active)
+{
+    t_active = s_options.m_enabled;
+}
+
+Scope::~Scope()
+{
+    t_active = m_previous;
+}
+
+void* tryAllocate(size_t size)
+{
+    if (!t_active)
+        return nullptr;
+
+    const size_t    alignment = size >= g_cacheLine ? g_cacheLine : g_smallAlignment;
+    std::lock_guard lock(s_mutex);
+    char*           begin = s_rangeBegin.load(std::memory_order_relaxed);
+    if (!begin) {
+        size_t rangeSize = 0;
+        begin            = reserveRange(rangeSize);
+        if (!begin)
+            return nullptr;
+        s_rangeBegin.store(begin, std::memory_order_relaxed);
+        s_rangeEnd.store(begin + rangeSize, std::memory_order_release);
+    }
+    const size_t rangeSize = s_rangeEnd.load(std::memory_order_relaxed) - begin;
+    // range begin is page aligned, so aligned offset gives aligned address.
+    const size_t offset = (s_offset + alignment - 1) / alignment * alignment;
+    if (size > rangeSize - offset)
+        return nullptr;
+    if (offset + size > s_committed) {
+        const size_t committed = std::min(rangeSize, (offset + size + g_blockSize - 1) / g_blockSize * g_blockSize);
+        if (!commitBlock(begin + s_committed, committed - s_committed))
+            return nullptr;
+        s_stats.m_reservedBytes += committed - s_committed;
+        s_stats.m_blocks++;
+        s_committed = committed;
+    }
+    s_offset = offset + size;
+    s_stats.m_usedBytes += size;
+    s_stats.m_allocations++;
+    return begin + offset;
+}
+
+bool owns(const void* ptr)
+{
+    // both are null until first arena allocation, so nothing is owned.
+    const char* end = s_rangeEnd.load(std::memory_order_acquire);
+    const char* p   = static_cast<const char*>(ptr);
+    return p < end && p >= s_rangeBegin.load(std::memory_order_relaxed);
+}
+
+Stats getStats()
+{
+    std::lock_guard lock(s_mutex);
+    return s_stats;
+}
+
+}
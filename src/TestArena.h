@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2025 Smirnov Vladimir / mapron1@gmail.com
+ * SPDX-License-Identifier: CC0-1.0
+ * See LICENSE file for details.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+/// Contiguous storage for test data. While Scope is alive, every operator new on its thread is served from big arena blocks
+/// by bumping a pointer, and operator delete of arena memory does nothing. So test case lists keep their usual types
+/// (std::vector, std::string inside IO types), but loading does not call malloc for each case and all cases of a source
+/// lie next to each other in memory.
+/// Works only with ENABLE_NEW_DELETE_HOOK (default), otherwise Scope has no effect.
+namespace TestArena {
+
+struct Options {
+    bool m_enabled   = false;
+    bool m_hugePages = false; // ask OS for transparent huge pages for arena blocks (Linux).
+    bool m_prefault  = false; // touch every page of loaded data, so first solution does not pay for faults.
+    bool m_willNeed  = false; // madvise(MADV_WILLNEED) for loaded data, brings back pages which were swapped out (Linux).
+    bool m_lock      = false; // mlock() loaded data, so it is not swapped out between solutions (Linux).
+};
+
+/// Must be called before test data is loaded (before CallbackList::callAll()).
+void configure(const Options& options);
+
+const Options& getOptions();
+
+/// Applies m_prefault, m_willNeed and m_lock to loaded data; must be called after test data is loaded.
+/// Returns false if memory could not be locked (usually RLIMIT_MEMLOCK is too small), other options still take effect.
+bool prepareLoaded();
+
+/// Makes operator new on current thread use arena, if arena is enabled. Scopes can be nested.
+class Scope {
+public:
+    Scope();
+    ~Scope();
+    Scope(const Scope&)            = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    bool m_previous = false;
+};
+
+/// Places value that was built in usual memory into arena: streams, parsing temporaries and regrowth of containers stay
+/// outside, only final buffers are copied, next to previously placed data. Without arena value is just moved.
+template<class T>
+T place(T value)
+{
+    if (!getOptions().m_enabled)
+        return value;
+    const Scope scope;
+    return T(std::as_const(value));
+}
+
+/// Returns nullptr when there is no active Scope on current thread. Allocations of 64 bytes and more are cache line aligned.
+void* tryAllocate(size_t size);
+
+/// Whether pointer belongs to arena, so it must not be freed.
+bool owns(const void* ptr);
+
+struct Stats {
+    uint64_t m_usedBytes     = 0;
+    uint64_t m_reservedBytes = 0;
+    uint64_t m_allocations   = 0;
+    size_t   m_blocks        = 0;
+};
+Stats getStats();
+
+}
@@ -0,0 +1,339 @@
+/*
+ * Copyright (C) 2025 Smirnov Vladimir / mapron1@gmail.com
+ * SPDX-License-Identifier: CC0-1.0
+ * See LICENSE file for details.
+ */
+#include "TestFiles.h"
+
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#ifdef CONTEST_CHECKER_HAS_ZLIB
+#include <zlib.h>
+#endif
+#ifdef CONTEST_CHECKER_HAS_ZSTD
+#include <zstd.h>
+#endif
+
+namespace TestFiles {
+namespace {
+
+constexpr size_t g_chunkSize   = 1 << 20;
+constexpr size_t g_bufferCount = 4; // decompressed chunks in flight, limits memory to few MB per file.
+
+bool endsWith(const std::string& value, std::string_view suffix)
+{
+    return value.size() >= suffix.size() && value.compare(value.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+/// Produces decompressed bytes; returns 0 at the end of data, throws on error.
+class Decoder {
+public:
+    explicit Decoder(const std::string& path)
+        : m_path(path)
+        , m_file(path, std::ios::binary)
+    {
+        if (!m_file)
+            throw std::runtime_error("Failed to open " + path);
+    }
+    virtual ~Decoder() = default;
+
+    virtual size_t decode(char* output, size_t capacity) = 0;
+
+protected:
+    /// Refill m_input when it is consumed; returns false at end of file.
+    bool readInput()
+    {
+        if (m_inputPos < m_inputSize)
+            return true;
+        m_file.read(m_input.data(), std::streamsize(m_input.size()));
+        m_inputSize = size_t(m_file.gcount());
+        m_inputPos  = 0;
+        if (m_file.bad())
+            throw std::runtime_error("Failed to read " + m_path);
+        return m_inputSize > 0;
+    }
+
+protected:
+    std::string       m_path;
+    std::ifstream     m_file;
+    std::vector<char> m_input     = std::vector<char>(g_chunkSize / 4);
+    size_t            m_inputSize = 0;
+    size_t            m_inputPos  = 0;
+};
+
+#ifdef CONTEST_CHECKER_HAS_ZLIB
+class GzipDecoder : public Decoder {
+public:
+    explicit GzipDecoder(const std::string& path)
+        : Decoder(path)
+    {
+        // 32 enables gzip header detection.
+        if (inflateInit2(&m_stream, 15 + 32) != Z_OK)
+            throw std::runtime_error("inflateInit2 failed");
+    }
+    ~GzipDecoder() override { inflateEnd(&m_stream); }
+
+    size_t decode(char* output, size_t capacity) override
+    {
+        m_stream.next_out  = reinterpret_cast<Bytef*>(output);
+        m_stream.avail_out = uInt(capacity);
+        while (m_stream.avail_out > 0) {
+            if (!readInput()) {
+                if (m_inMember)
+                    throw std::runtime_error("Unexpected end of gzip data in " + m_path);
+                break;
+            }
+            m_stream.next_in  = reinterpret_cast<Bytef*>(m_input.data() + m_inputPos);
+            m_stream.avail_in = uInt(m_inputSize - m_inputPos);
+            const int result  = inflate(&m_stream, Z_NO_FLUSH);
+            m_inputPos        = m_inputSize - m_stream.avail_in;
+            m_inMember        = result != Z_STREAM_END;
+            if (result == Z_STREAM_END) {
+                // file can contain several concatenated gzip members.
+                inflateReset(&m_stream);
+                continue;
+            }
+            if (result != Z_OK && result != Z_BUF_ERROR)
+                throw std::runtime_error("Corrupted gzip data in " + m_path + ": " + (m_stream.msg ? m_stream.msg : "unknown error"));
+        }
+        return capacity - m_stream.avail_out;
+    }
+
+private:
+    z_stream m_stream{};
+    bool     m_inMember = false;
+};
+#endif
+
+#ifdef CONTEST_CHECKER_HAS_ZSTD
+class ZstdDecoder : public Decoder {
+public:
+    explicit ZstdDecoder(const std::string& path)
+        : Decoder(path)
+        , m_stream(ZSTD_createDStream())
+    {
+        if (!m_stream)
+            throw std::runtime_error("ZSTD_createDStream failed");
+    }
+    ~ZstdDecoder() override { ZSTD_freeDStream(m_stream); }
+
+    size_t decode(char* output, size_t capacity) override
+    {
+        ZSTD_outBuffer out{ output, capacity, 0 };
+        while (out.pos < out.size) {
+            if (!readInput()) {
+                if (m_inFrame)
+                    throw std::runtime_error("Unexpected end of zstd data in " + m_path);
+                break;
+            }
+            ZSTD_inBuffer in{ m_input.data(), m_inputSize, m_inputPos };
+            const size_t  result = ZSTD_decompressStream(m_stream, &out, &in);
+            m_inputPos           = in.pos;
+            if (ZSTD_isError(result))
+                throw std::runtime_error("Corrupted zstd data in " + m_path + ": " + ZSTD_getErrorName(result));
+            // zero means frame is complete and fully flushed.
+            m_inFrame = result != 0;
+        }
+        return out.pos;
+    }
+
+private:
+    ZSTD_DStream* m_stream;
+    bool          m_inFrame = false;
+};
+#endif
+
+/// Stream buffer fed by decoder on a background thread; consumer gets full chunks from the queue.
+class PipelinedBuf : public std::streambuf {
+public:
+    explicit PipelinedBuf(std::unique_ptr<Decoder> decoder)
+        : m_decoder(std::move(decoder))
+    {
+        for (size_t i = 0; i < g_bufferCount; ++i)
+            m_free.emplace_back(g_chunkSize);
+        m_thread = std::thread([this] { produce(); });
+    }
+
+    ~PipelinedBuf() override
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stop = true;
+        }
+        m_condition.notify_all();
+        m_thread.join();
+    }
+
+protected:
+    int_type underflow() override
+    {
+        std::unique_lock lock(m_mutex);
+        if (!m_current.empty()) {
+            m_free.push_back(std::move(m_current));
+            m_current = {};
+            m_condition.notify_all();
+        }
+        m_condition.wait(lock, [this] { return !m_ready.empty() || m_finished; });
+        if (m_ready.empty()) {
+            if (!m_error.empty())
+                throw std::runtime_error(m_error);
+            return traits_type::eof();
+        }
+        m_current = std::move(m_ready.front().first);
+        const size_t size = m_ready.front().second;
+        m_ready.pop_front();
+        setg(m_current.data(), m_current.data(), m_current.data() + size);
+        return traits_type::to_int_type(m_current[0]);
+    }
+
+private:
+    void produce()
+    {
+        try {
+            while (true) {
+                std::vector<char> buffer;
+                {
+                    std::unique_lock lock(m_mutex);
+                    m_condition.wait(lock, [this] { return !m_free.empty() || m_stop; });
+                    if (m_stop)
+                        break;
+                    buffer = std::move(m_free.back());
+                    m_free.pop_back();
+                }
+                const size_t size = m_decoder->decode(buffer.data(), buffer.size());
+                if (!size)
+                    break;
+                {
+                    std::lock_guard lock(m_mutex);
+                    m_ready.emplace_back(std::move(buffer), size);
+                }
+                m_condition.notify_all();
+            }
+        }
+        catch (std::exception& ex) {
+            std::lock_guard lock(m_mutex);
+            m_error = ex.what();
+        }
+        {
+            std::lock_guard lock(m_mutex);
+            m_finished = true;
+        }
+        m_condition.notify_all();
+    }
+
+private:
+    std::unique_ptr<Decoder> m_decoder;
+    std::thread              m_thread;
+    std::mutex               m_mutex;
+    std::condition_variable  m_condition;
+
+    std::deque<std::pair<std::vector<char>, size_t>> m_ready;
+    std::vector<std::vector<char>>                   m_free;
+    std::vector<char>                                m_current; // owned by consumer while its data is in get area.
+
+    std::string m_error;
+    bool        m_stop     = false;
+    bool        m_finished = false;
+};
+
+/// Owns the buffer, so it is destroyed after the stream.
+class PipelinedStream : public std::istream {
+public:
+    explicit PipelinedStream(std::unique_ptr<Decoder> decoder)
+        : std::istream(nullptr)
+        , m_buf(std::move(decoder))
+    {
+        rdbuf(&m_buf);
+    }
+
+private:
+    PipelinedBuf m_buf;
+};
+
+std::unique_ptr<Decoder> makeDecoder(const std::string& path)
+{
+#ifdef CONTEST_CHECKER_HAS_ZLIB
+    if (endsWith(path, ".gz"))
+        return std::make_unique<GzipDecoder>(path);
+#endif
+#ifdef CONTEST_CHECKER_HAS_ZSTD
+    if (endsWith(path, ".zst"))
+        return std::make_unique<ZstdDecoder>(path);
+#endif
+    return nullptr;
+}
+
+}
+
+bool isSupported(const std::string& path)
+{
+#ifdef CONTEST_CHECKER_HAS_ZLIB
+    if (endsWith(path, ".txt.gz"))
+        return true;
+#endif
+#ifdef CONTEST_CHECKER_HAS_ZSTD
+    if (endsWith(path, ".txt.zst"))
+        return true;
+#endif
+    return endsWith(path, ".txt");
+}
+
+std::string findVariant(const std::string& basePath)
+{
+    for (const char* suffix : { ".txt", ".txt.gz", ".txt.zst" }) {
+        const std::string path = basePath + suffix;
+        if (isSupported(path) && std::filesystem::exists(path))
+            return path;
+    }
+    return {};
+}
+
+std::unique_ptr<std::istream> open(const std::string& path)
+{
+    std::unique_ptr<std::istream> result;
+    if (auto decoder = makeDecoder(path)) {
+        result = std::make_unique<PipelinedStream>(std::move(decoder));
+    } else {
+        auto file = std::make_unique<std::ifstream>(path, std::ios::binary);
+        if (!*file)
+            throw std::runtime_error("Failed to open " + (path.empty() ? std::string("test file") : path));
+        result = std::move(file);
+    }
+    result->exceptions(std::ios::failbit | std::ios::badbit);
+    return result;
+}
+
+uint64_t getContentSize(const std::string& path)
+{
+    std::error_code ec;
+    const uint64_t  fileSize = std::filesystem::file_size(path, ec);
+    if (ec)
+        return 0;
+    std::ifstream file(path, std::ios::binary);
+    if (endsWith(path, ".gz") && fileSize >= 4) {
+        // ISIZE is the uncompressed size modulo 2^32 of the last member.
+        unsigned char trailer[4] = {};
+        file.seekg(-4, std::ios::end);
+        file.read(reinterpret_cast<char*>(trailer), 4);
+        return uint64_t(trailer[0]) | uint64_t(trailer[1]) << 8 | uint64_t(trailer[2]) << 16 | uint64_t(trailer[3]) << 24;
+    }
+#ifdef CONTEST_CHECKER_HAS_ZSTD
+    if (endsWith(path, ".zst")) {
+        char header[ZSTD_FRAMEHEADERSIZE_MAX] = {};
+        file.read(header, sizeof(header));
+        const unsigned long long size = ZSTD_getFrameContentSize(header, size_t(file.gcount()));
+        if (size != ZSTD_CONTENTSIZE_UNKNOWN && size != ZSTD_CONTENTSIZE_ERROR)
+            return size;
+    }
+#endif
+    return fileSize;
+}
+
+}
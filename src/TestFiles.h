@@ -0,0 +1,30 @@
+/*
+ * Copyright (C) 2025 Smirnov Vladimir / mapron1@gmail.com
+ * SPDX-License-Identifier: CC0-1.0
+ * See LICENSE file for details.
+ */
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <string>
+
+/// Access to test data files, which can be plain text or compressed: "input_0.txt", "input_0.txt.gz" or "input_0.txt.zst".
+/// Compressed file is decompressed on a background thread into a small queue of buffers, while caller parses
+/// already decompressed part; so reading, decompression and parsing overlap and nothing is expanded to disk.
+namespace TestFiles {
+
+/// Whether build can read files with this suffix (".txt", ".txt.gz", ".txt.zst").
+bool isSupported(const std::string& path);
+
+/// Existing variant of basePath + ".txt" (plain file is preferred); empty if there is none.
+std::string findVariant(const std::string& basePath);
+
+/// Opens plain or compressed file. Stream throws on read errors, corrupted data and if file can not be opened.
+std::unique_ptr<std::istream> open(const std::string& path);
+
+/// Size of decompressed content: taken from gzip trailer or zstd frame header, file size for plain files.
+uint64_t getContentSize(const std::string& path);
+
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2025 Smirnov Vladimir / mapron1@gmail.com
+ * SPDX-License-Identifier: CC0-1.0
+ * See LICENSE file for details.
+ */
+#include "Tracing.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <iostream>
+
+namespace Tracing {
+namespace {
+
+constexpr size_t g_ringSize = 16384; // per thread, power of two.
+
+struct ThreadBuffer {
+    Event                 m_events[g_ringSize];
+    std::atomic<uint64_t> m_head{ 0 }; // total count of recorded events.
+    uint32_t              m_threadId = 0;
+    ThreadBuffer*         m_next     = nullptr;
+};
+
+std::atomic<ThreadBuffer*> s_buffers{ nullptr };
+std::atomic<uint32_t>      s_threadCount{ 0 };
+
+ThreadBuffer* createBuffer()
+{
+    // calloc instead of new: buffer should not appear in allocation statistics of code being measured.
+    // Buffers are never freed, so events of finished threads are still available for writing.
+    auto* buffer       = static_cast<ThreadBuffer*>(std::calloc(1, sizeof(ThreadBuffer)));
+    buffer->m_threadId = ++s_threadCount;
+    buffer->m_next     = s_buffers.load();
+    while (!s_buffers.compare_exchange_weak(buffer->m_next, buffer)) {
+    }
+    return buffer;
+}
+
+void writeEscaped(std::ostream& os, const char* str)
+{
+    for (; *str; ++str) {
+        const char c = *str;
+        if (c == '"' || c == '\\')
+            os << '\\' << c;
+        else if (static_cast<unsigned char>(c) < 0x20)
+            os << ' ';
+        else
+            os << c;
+    }
+}
+
+}
+
+void record(const Event& event)
+{
+    thread_local ThreadBuffer* t_buffer = createBuffer();
+
+    const uint64_t head                   = t_buffer->m_head.load(std::memory_order_relaxed);
+    t_buffer->m_events[head % g_ringSize] = event;
+    t_buffer->m_head.store(head + 1, std::memory_order_release);
+}
+
+bool writeTo(const std::string& path, std::ostream& log)
+{
+    std::ofstream os(path, std::ios::binary);
+    if (!os) {
+        log << "Failed to open trace file '" << path << "'\n";
+        return false;
+    }
+    os << std::fixed << std::setprecision(3);
+    os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    bool    first    = true;
+    size_t  dropped  = 0;
+    int64_t originNs = std::numeric_limits<int64_t>::max();
+    for (ThreadBuffer* buffer = s_buffers.load(); buffer; buffer = buffer->m_next) {
+        const uint64_t head = buffer->m_head.load(std::memory_order_acquire);
+        for (uint64_t i = head > g_ringSize ? head - g_ringSize : 0; i < head; ++i)
+            originNs = std::min(originNs, buffer->m_events[i % g_ringSize].m_startNs);
+    }
+    for (ThreadBuffer* buffer = s_buffers.load(); buffer; buffer = buffer->m_next) {
+        const uint64_t head  = buffer->m_head.load(std::memory_order_acquire);
+        const uint64_t begin = head > g_ringSize ? head - g_ringSize : 0;
+        dropped += begin;
+
+        os << (first ? "" : ",\n") << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buffer->m_threadId
+           << ",\"args\":{\"name\":\"" << (buffer->m_threadId == 1 ? "main" : "thread") << "\"}}";
+        first = false;
+        for (uint64_t i = begin; i < head; ++i) {
+            const Event& event = buffer->m_events[i % g_ringSize];
+            os << ",\n{\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->m_threadId << ",\"name\":\"";
+            writeEscaped(os, event.m_name);
+            os << "\",\"cat\":\"" << event.m_category << "\""
+               << ",\"ts\":" << (event.m_startNs - originNs) / 1000.0
+               << ",\"dur\":" << event.m_durationNs / 1000.0
+               << ",\"args\":{\"newCalls\":" << event.m_newInfo.m_calls
+               << ",\"newBytes\":" << event.m_newInfo.m_totalBytes
+               << ",\"newTimeNs\":" << event.m_newInfo.m_timeSpentNanosec
+               << ",\"deleteCalls\":" << event.m_deleteInfo.m_calls
+               << ",\"deleteTimeNs\":" << event.m_deleteInfo.m_timeSpentNanosec;
+            if (event.m_argName)
+                os << ",\"" << event.m_argName << "\":" << event.m_argValue;
+            os << "}}";
+        }
+    }
+    os << "\n]}\n";
+    if (dropped)
+        log << "Trace: " << dropped << " oldest events were overwritten.\n";
+    return true;
+}
+
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2025 Smirnov Vladimir / mapron1@gmail.com
+ * SPDX-License-Identifier: CC0-1.0
+ * See LICENSE file for details.
+ */
+#pragma once
+
+#include "CustomAlloc.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+/// Timeline of run phases, exported in Chrome Trace Event Format (chrome://tracing, ui.perfetto.dev).
+/// Tracing is always on: spans go into fixed-size per-thread ring buffers (oldest are overwritten),
+/// recording never allocates and never takes a lock, file is written only if requested.
+namespace Tracing {
+
+/// Complete event ("X" phase in trace format). Fixed size, so it can be copied into a ring buffer as is.
+struct Event {
+    char        m_name[48]   = {};
+    const char* m_category   = "";
+    const char* m_argName    = nullptr; // optional numeric argument, e.g. case index or iteration count.
+    int64_t     m_argValue   = 0;
+    int64_t     m_startNs    = 0;
+    int64_t     m_durationNs = 0;
+
+    CustomAlloc::Info m_newInfo;
+    CustomAlloc::Info m_deleteInfo;
+};
+
+/// Store event in ring buffer of the current thread.
+void record(const Event& event);
+
+/// Write all events recorded so far. Should be called when other threads are not recording.
+bool writeTo(const std::string& path, std::ostream& log);
+
+/// Measures time and allocations from construction to destruction.
+class Span {
+public:
+    Span(std::string_view name, const char* category)
+    {
+        const size_t size = std::min(name.size(), sizeof(m_event.m_name) - 1);
+        std::copy_n(name.data(), size, m_event.m_name);
+        m_event.m_category   = category;
+        m_event.m_newInfo    = CustomAlloc::getNewInfo();
+        m_event.m_deleteInfo = CustomAlloc::getDeleteInfo();
+        m_event.m_startNs    = PerformanceCounterDetails::getCurrentNanoseconds();
+    }
+    ~Span()
+    {
+        m_event.m_durationNs = PerformanceCounterDetails::getCurrentNanoseconds() - m_event.m_startNs;
+        m_event.m_newInfo    = CustomAlloc::getNewInfo() - m_event.m_newInfo;
+        m_event.m_deleteInfo = CustomAlloc::getDeleteInfo() - m_event.m_deleteInfo;
+        record(m_event);
+    }
+    Span(const Span&)            = delete;
+    Span& operator=(const Span&) = delete;
+
+    void setArg(const char* name, int64_t value)
+    {
+        m_event.m_argName  = name;
+        m_event.m_argValue = value;
+    }
+
+    int64_t getElapsedNs() const { return PerformanceCounterDetails::getCurrentNanoseconds() - m_event.m_startNs; }
+
+private:
+    Event m_event;
+};
+
+}
@@ -4,27 +4,66 @@
  * See LICENSE file for details.
  */
 
+#include "Calibration.h"
 #include "CommonTestUtils.h"
+#include "Coordinator.h"
+#include "CustomAlloc.h"
+#include "PluginLoader.h"
+#include "Server.h"
+#include "StreamingCompare.h"
+#include "TestArena.h"
 
 int main(int argc, char** argv)
 {
     try {
-        CallbackList::callAll();
-
         CLIParams params;
         if (!params.parseArgs(std::cerr, argc, argv))
             return 1;
 
-        params.createStreams();
+        // arguments are parsed first, as they affect how test data is loaded.
+        // arena works through new() replacement, without it the option would silently do nothing.
+        const bool testArena = params.m_testArena && CustomAlloc::isHookEnabled();
+        if (params.m_testArena && !testArena)
+            std::cerr << "Test data arena requires build with ENABLE_NEW_DELETE_HOOK=ON, '--test-arena' options are ignored.\n";
+        TestArena::configure({
+            .m_enabled   = testArena,
+            .m_hugePages = params.m_testArenaHugePages,
+            .m_prefault  = params.m_testArenaPrefault,
+            .m_willNeed  = params.m_testArenaWillNeed,
+            .m_lock      = params.m_testArenaLock,
+        });
+        StreamingCompare::setHashThreshold(uint64_t(std::max<int64_t>(params.m_hashOutputsAboveMB, 0)) << 20);
+        Calibration::setCachePath(params.m_calibrationFile.empty() ? Calibration::getDefaultCachePath()
+                                  : params.m_calibrationFile == CLIParams::g_null ? std::string()
+                                                                                  : params.m_calibrationFile);
+        CallbackList::callAll();
 
-        PerformanceCounter topCounter(std::array<Perf, 2>{ Perf::ExecTime, Perf::PeakHeap });
-        auto&              allDesc = AbstractProblemData::getSortedProblemRunners();
-        for (auto&& cb : allDesc) {
-            if (!cb.m_cb(params))
-                return 1;
+        params.createStreams();
+        if (testArena) {
+            const TestArena::Stats stats = TestArena::getStats();
+            *params.m_loggingStream << "Test data arena: " << stats.m_usedBytes / 1024 << " kB in " << stats.m_allocations << " allocations, "
+                                    << stats.m_reservedBytes / 1024 << " kB reserved in " << stats.m_blocks << " blocks.\n";
+            if (!TestArena::prepareLoaded())
+                *params.m_loggingStream << "Test data arena could not be locked in memory, check RLIMIT_MEMLOCK ('ulimit -l').\n";
         }
-        (*params.m_loggingStream) << "Finished";
-        topCounter.printTo(*params.m_loggingStream, true);
+
+        if (params.m_task == CLIParams::Task::Serve)
+            return Server::serve(params, argc, argv) ? 0 : 1;
+        if (!params.m_socketPath.empty())
+            return Server::sendRequest(params, argc, argv) ? 0 : 1;
+
+        // solutions of other plugins are still checked, but overall result is failure.
+        const bool pluginsLoaded = PluginLoader::refresh(params.m_pluginPaths, *params.m_loggingStream);
+
+        if (!params.m_connectAddress.empty())
+            return Coordinator::runWorker(params) ? 0 : 1;
+
+        const bool result = params.m_workerCount >= 0 ? Coordinator::runCoordinator(params)
+                                                      : AbstractProblemData::runAll(params);
+        if (!params.m_traceFile.empty())
+            Tracing::writeTo(params.m_traceFile, *params.m_loggingStream);
+        if (!result || !pluginsLoaded)
+            return 1;
     }
     catch (std::runtime_error& ex) {
         std::cerr << "std::exception was thrown:" << ex.what() << "\n";
@@ -0,0 +1,34 @@
+#!/bin/sh
+# Incremental server checks: a pass with narrower source filter or without time limits must not let a later full run skip tests.
+# Usage: ServerIncremental.sh <path to ContestChecker>
+checker="$1"
+dir=$(mktemp -d)
+socket="$dir/checker.sock"
+trap 'kill $server 2>/dev/null; rm -rf "$dir"' EXIT
+
+"$checker" --task Serve --socket "$socket" > "$dir/server.log" 2>&1 &
+server=$!
+for i in $(seq 50); do
+    [ -S "$socket" ] && break
+    sleep 0.1
+done
+
+request() {
+    "$checker" --socket "$socket" --impl nooverflow --no-cache 1 "$@" > "$dir/out.log" 2>&1 || { cat "$dir/out.log"; echo "FAIL: request '$*' failed"; exit 1; }
+}
+expectRun() {
+    request "$@"
+    grep -q "solution 'nooverflow' tests" "$dir/out.log" || { cat "$dir/out.log"; echo "FAIL: request '$*' did not run tests"; exit 1; }
+}
+expectSkip() {
+    request "$@"
+    grep -q "unchanged since last pass" "$dir/out.log" || { cat "$dir/out.log"; echo "FAIL: request '$*' was not skipped"; exit 1; }
+}
+
+expectRun --source code --time-limits 0
+expectRun --time-limits 0
+expectSkip --source file --time-limits 0
+expectRun
+expectSkip
+expectSkip --time-limits 0
+echo "OK"